@@ -1,25 +1,26 @@
 #include "AudioManager.hpp"
+#include "Log.hpp"
 #include <SFML/Audio.hpp>
 #include <iostream>
 
 AudioManager::AudioManager() {
-    std::cout << "🎵 AudioManager initializing with SFML sound support..." << std::endl;
+    KFC_INFO(Audio, "🎵 AudioManager initializing with SFML sound support...");
     
     // Load sound buffers
     if (!moveBuffer.loadFromFile("sounds/move.mp3")) {
-        std::cout << "❌ Failed to load move.mp3" << std::endl;
+        KFC_WARN(Audio, "❌ Failed to load move.mp3");
     }
     if (!captureBuffer.loadFromFile("sounds/capture.mp3")) {
-        std::cout << "❌ Failed to load capture.mp3" << std::endl;
+        KFC_WARN(Audio, "❌ Failed to load capture.mp3");
     }
     if (!startBuffer.loadFromFile("sounds/start.mp3")) {
-        std::cout << "❌ Failed to load start.mp3" << std::endl;
+        KFC_WARN(Audio, "❌ Failed to load start.mp3");
     }
     if (!gameOverBuffer.loadFromFile("sounds/gameOver.mp3")) {
-        std::cout << "❌ Failed to load gameOver.mp3" << std::endl;
+        KFC_WARN(Audio, "❌ Failed to load gameOver.mp3");
     }
     if (!changeBuffer.loadFromFile("sounds/change.mp3")) {
-        std::cout << "❌ Failed to load change.mp3" << std::endl;
+        KFC_WARN(Audio, "❌ Failed to load change.mp3");
     }
     
     // Set buffers to sounds
@@ -29,7 +30,7 @@ AudioManager::AudioManager() {
     gameOverSound.setBuffer(gameOverBuffer);
     changeSound.setBuffer(changeBuffer);
     
-    std::cout << "🎵 AudioManager ready!" << std::endl;
+    KFC_INFO(Audio, "🎵 AudioManager ready!");
 }
 
 void AudioManager::onEvent(const GameEvent& event) {
@@ -47,26 +48,26 @@ void AudioManager::onEvent(const GameEvent& event) {
 }
 
 void AudioManager::playMoveSound() {
-    std::cout << "🎵 Playing: Piece moved" << std::endl;
+    KFC_DEBUG(Audio, "🎵 Playing: Piece moved");
     moveSound.play();
 }
 
 void AudioManager::playCaptureSound() {
-    std::cout << "🎵 Playing: Piece captured" << std::endl;
+    KFC_DEBUG(Audio, "🎵 Playing: Piece captured");
     captureSound.play();
 }
 
 void AudioManager::playGameStartSound() {
-    std::cout << "🎵 Playing: Game started" << std::endl;
+    KFC_DEBUG(Audio, "🎵 Playing: Game started");
     startSound.play();
 }
 
 void AudioManager::playGameEndSound() {
-    std::cout << "🎵 Playing: Game ended" << std::endl;
+    KFC_DEBUG(Audio, "🎵 Playing: Game ended");
     gameOverSound.play();
 }
 
 void AudioManager::playChangeSound() {
-    std::cout << "🎵 Playing: Pawn promotion" << std::endl;
+    KFC_DEBUG(Audio, "🎵 Playing: Pawn promotion");
     changeSound.play();
 }
\ No newline at end of file
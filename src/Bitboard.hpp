@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+// ---------------------------------------------------------------------------
+// 64-bit cell sets for boards of up to 64 cells (the 8x8 board). Cell
+// (row, col) maps to bit row * W_cells + col.
+// ---------------------------------------------------------------------------
+using Bitboard = uint64_t;
+
+namespace bitboard {
+
+constexpr int kMaxCells = 64;
+
+constexpr Bitboard bit(int index) { return Bitboard{1} << index; }
+
+constexpr bool test(Bitboard bb, int index) { return (bb >> index) & 1u; }
+
+inline int popcount(Bitboard bb) {
+    int n = 0;
+    while (bb) {
+        bb &= bb - 1;
+        ++n;
+    }
+    return n;
+}
+
+// Index of the lowest set bit (bb must be non-zero)
+inline int lsb(Bitboard bb) {
+    static const int kDeBruijnIndex[64] = {
+         0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+    };
+    const Bitboard isolated = bb & (~bb + 1);
+    return kDeBruijnIndex[(isolated * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+// Removes and returns the lowest set bit's index (bb must be non-zero)
+inline int pop_lsb(Bitboard& bb) {
+    int index = lsb(bb);
+    bb &= bb - 1;
+    return index;
+}
+
+} // namespace bitboard
+
+// Occupied cells of the whole board plus per-color sub-boards
+struct BoardOccupancy {
+    Bitboard all = 0;
+    Bitboard white = 0;
+    Bitboard black = 0;
+
+    Bitboard of_color(char color) const {
+        if (color == 'W') return white;
+        if (color == 'B') return black;
+        return 0;
+    }
+};
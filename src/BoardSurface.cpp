@@ -0,0 +1,111 @@
+#include "BoardSurface.hpp"
+
+#include <algorithm>
+
+namespace {
+// cv::rectangle draws a 3px border centred on the edge
+constexpr int kMarkerBleed = 2;
+
+bool same_marker(const BoardSurface::Marker& a, const BoardSurface::Marker& b) {
+    return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h && a.color == b.color;
+}
+}
+
+Rect BoardSurface::bounds(const Sprite& s) {
+    if (!s.img) return Rect{};
+    auto size = s.img->size();
+    return Rect{s.x, s.y, size.first, size.second};
+}
+
+Rect BoardSurface::bounds(const Marker& m) {
+    return Rect{m.x - kMarkerBleed, m.y - kMarkerBleed, m.w + 2 * kMarkerBleed, m.h + 2 * kMarkerBleed};
+}
+
+bool BoardSurface::is_damaged(const Rect& r) const {
+    return std::any_of(damage.begin(), damage.end(), [&r](const Rect& d) { return d.intersects(r); });
+}
+
+// ---------------------------------------------------------------------------
+const std::vector<Rect>& BoardSurface::render(const Img& pristine,
+                                              const std::vector<Sprite>& sprites,
+                                              const std::vector<Marker>& markers) {
+    damage.clear();
+    auto board_size = pristine.size();
+
+    if (!surface_) {
+        surface_ = pristine.clone();
+        full_redraw = true;
+    }
+
+    if (full_redraw) {
+        damage.push_back(Rect{0, 0, board_size.first, board_size.second});
+    } else {
+        // Sprites that moved, changed frame, appeared or disappeared
+        size_t matched = 0;
+        for (const auto& s : sprites) {
+            auto it = last_sprites.find(s.key);
+            if (it == last_sprites.end()) {
+                damage.push_back(bounds(s));
+                continue;
+            }
+            ++matched;
+            if (it->second.img != s.img || it->second.x != s.x || it->second.y != s.y) {
+                damage.push_back(bounds(it->second));
+                damage.push_back(bounds(s));
+            }
+        }
+        if (matched < last_sprites.size()) {
+            for (const auto& [key, old] : last_sprites) {
+                bool alive = std::any_of(sprites.begin(), sprites.end(),
+                                         [k = key](const Sprite& s) { return s.key == k; });
+                if (!alive) damage.push_back(bounds(old));
+            }
+        }
+
+        // Cursors that moved or changed color
+        for (size_t i = 0; i < std::max(markers.size(), last_markers.size()); ++i) {
+            bool had = i < last_markers.size();
+            bool has = i < markers.size();
+            if (had && has && same_marker(last_markers[i], markers[i])) continue;
+            if (had) damage.push_back(bounds(last_markers[i]));
+            if (has) damage.push_back(bounds(markers[i]));
+        }
+    }
+
+    damage.erase(std::remove_if(damage.begin(), damage.end(), [](const Rect& r) { return r.empty(); }),
+                 damage.end());
+
+    if (!damage.empty()) {
+        // A sprite touching a damaged area is redrawn whole, so its full bounds
+        // become damaged too (sprites overlapping it must be redrawn after it)
+        redraw.assign(sprites.size(), 0);
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (size_t i = 0; i < sprites.size(); ++i) {
+                if (redraw[i]) continue;
+                Rect r = bounds(sprites[i]);
+                if (!r.empty() && is_damaged(r)) {
+                    redraw[i] = 1;
+                    damage.push_back(r);
+                    grew = true;
+                }
+            }
+        }
+
+        for (const auto& r : damage) {
+            pristine.copy_region_to(*surface_, r.x, r.y, r.w, r.h, r.x, r.y);
+        }
+        for (size_t i = 0; i < sprites.size(); ++i) {
+            if (redraw[i]) sprites[i].img->draw_on(*surface_, sprites[i].x, sprites[i].y);
+        }
+        for (const auto& m : markers) {
+            if (is_damaged(bounds(m))) surface_->draw_rect(m.x, m.y, m.w, m.h, m.color);
+        }
+    }
+
+    full_redraw = false;
+    last_sprites.clear();
+    for (const auto& s : sprites) last_sprites.emplace(s.key, s);
+    last_markers = markers;
+    return damage;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "img/Img.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct Rect {
+    int x{0}, y{0}, w{0}, h{0};
+
+    bool empty() const { return w <= 0 || h <= 0; }
+    bool intersects(const Rect& o) const {
+        return x < o.x + o.w && o.x < x + w && y < o.y + o.h && o.y < y + h;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Persistent board image that is only repainted where something changed.
+// Each frame the caller hands over the sprites (in draw order) and the
+// cursor markers. Rectangles that changed since the last frame are found
+// from the old and new bounds of moved sprites, animation frame changes and
+// cursor moves. Only those rectangles are restored from the pristine board
+// and redrawn. A quiet board costs no pixel work at all.
+// ---------------------------------------------------------------------------
+class BoardSurface {
+public:
+    struct Sprite {
+        const void* key;    // identity across frames (the piece)
+        ImgPtr img;         // current animation frame
+        int x, y;
+    };
+    struct Marker {
+        int x, y, w, h;
+        std::vector<uint8_t> color;
+    };
+
+    // Repaint the damaged parts of the surface; returns them (board pixels)
+    const std::vector<Rect>& render(const Img& pristine,
+                                    const std::vector<Sprite>& sprites,
+                                    const std::vector<Marker>& markers);
+
+    ImgPtr surface() const { return surface_; }
+    // Force a full repaint on the next render
+    void invalidate() { full_redraw = true; }
+
+private:
+    ImgPtr surface_;
+    bool full_redraw{true};
+    std::unordered_map<const void*, Sprite> last_sprites;
+    std::vector<Marker> last_markers;
+
+    std::vector<Rect> damage;          // reused between frames
+    std::vector<char> redraw;          // per current sprite
+
+    static Rect bounds(const Sprite& s);
+    static Rect bounds(const Marker& m);
+    bool is_damaged(const Rect& r) const;
+};
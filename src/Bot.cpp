@@ -0,0 +1,357 @@
+#include "Bot.hpp"
+#include "Bitboard.hpp"
+#include "ScoreManager.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+
+namespace {
+constexpr int kPlyMs = 1000;            // game time covered by one ply
+constexpr int kKingValue = 1000;        // ScoreManager scores the king 0: losing it ends the game
+constexpr int kMate = 1000000;
+constexpr int kInfinity = INT_MAX / 2;
+constexpr int kMaxPieces = 64;
+
+int piece_value(char type) {
+    return type == 'K' ? kKingValue * 100 : ScoreManager::get_piece_value(type) * 100;
+}
+
+// Small positional tie-breaker: central cells, advanced pawns
+int placement(char type, char color, int row, int col) {
+    if (type == 'K') return 0;
+    int center = 7 - std::abs(2 * row - 7) / 2 - std::abs(2 * col - 7) / 2;
+    int advance = 0;
+    if (type == 'P') advance = color == 'W' ? 7 - row : row;
+    return center * 2 + advance * 4;
+}
+
+class Search {
+public:
+    Search(const BotPosition& position, std::chrono::steady_clock::time_point deadline)
+        : position(position), deadline(deadline) {
+        board.fill(-1);
+        for (const auto& p : position.pieces) {
+            if (pieces.size() == kMaxPieces) break;
+            int cell = p.cell.first * 8 + p.cell.second;
+            if (p.cell.first < 0 || p.cell.first >= 8 || p.cell.second < 0 || p.cell.second >= 8) continue;
+            Node node;
+            node.src = &p;
+            node.side = p.color == position.color ? 0 : 1;
+            node.cell = cell;
+            node.ready_ms = p.ready_ms;
+            // Two pieces heading for one cell: the later one is left out
+            if (board[cell] >= 0) continue;
+            board[cell] = static_cast<int>(pieces.size());
+            occupied[node.side] |= bitboard::bit(cell);
+            pieces.push_back(node);
+        }
+    }
+
+    BotDecision run(int max_depth) {
+        BotDecision decision;
+        std::vector<Move> root;
+        generate(0, 0, root);
+        if (root.size() == 1) {         // pass only
+            return decision;
+        }
+
+        stack.resize(max_depth + 1);
+        Move best{};
+        best.piece = -1;
+        for (int depth = 1; depth <= max_depth; ++depth) {
+            // Previous best first: its score bounds the rest early
+            auto it = std::find(root.begin(), root.end(), best);
+            if (it != root.end()) std::rotate(root.begin(), it, it + 1);
+
+            int alpha = -kInfinity;
+            Move depth_best{};
+            depth_best.piece = -1;
+            for (const auto& move : root) {
+                Undo undo = make(move, 0);
+                int score = -negamax(depth - 1, 1, -kInfinity, -alpha, 1);
+                unmake(move, undo);
+                if (aborted) break;
+                if (score > alpha) {
+                    alpha = score;
+                    depth_best = move;
+                }
+            }
+            if (aborted) break;
+            best = depth_best;
+            decision.score = alpha;
+            decision.depth = depth;
+            if (alpha >= kMate / 2) break;      // forced win found
+        }
+        decision.nodes = nodes;
+
+        if (best.piece < 0) return decision;    // no depth completed, or passing is best
+        const Node& node = pieces[best.piece];
+        const BotPiece& src = *node.src;
+        decision.pass = false;
+        decision.command.piece_id = src.id;
+        decision.command.player_id = position.color == 'W' ? 1 : 2;
+        if (best.jump) {
+            decision.command.type = "jump";
+            decision.command.params = {src.cell};
+        } else {
+            decision.command.type = "move";
+            decision.command.params = {src.cell, {best.to / 8, best.to % 8}};
+        }
+        return decision;
+    }
+
+private:
+    struct Node {
+        const BotPiece* src{nullptr};
+        int side{0};                // 0 = bot
+        int cell{0};
+        int ready_ms{0};
+        int immune_ply{-1};         // jumping during this ply
+        bool alive{true};
+    };
+    struct Move {
+        int piece{-1};              // -1 = pass
+        int to{0};
+        bool jump{false};
+        int order{0};
+        bool operator==(const Move& o) const { return piece == o.piece && to == o.to && jump == o.jump; }
+    };
+    struct Undo {
+        int from{0};
+        int ready_ms{0};
+        int immune_ply{-1};
+        int victim{-1};
+    };
+
+    const BotPosition& position;
+    std::chrono::steady_clock::time_point deadline;
+    std::vector<Node> pieces;
+    std::array<int, 64> board{};
+    Bitboard occupied[2] = {0, 0};
+    std::vector<std::vector<Move>> stack;     // move buffers per ply
+    uint64_t nodes{0};
+    bool aborted{false};
+
+    bool available(const Node& n, int ply) const {
+        return n.alive && n.src->moves && n.ready_ms <= ply * kPlyMs;
+    }
+
+    Bitboard targets(const Node& n) const {
+        return n.src->moves->generate({n.cell / 8, n.cell % 8}, occupied[0] | occupied[1], occupied[n.side]);
+    }
+
+    void generate(int side, int ply, std::vector<Move>& out) const {
+        out.clear();
+        out.push_back(Move{});      // pass
+
+        // Cells the other side can hit next ply: worth jumping out of
+        Bitboard threatened = 0;
+        for (const auto& n : pieces) {
+            if (n.side != side && available(n, ply + 1)) threatened |= targets(n);
+        }
+
+        for (int i = 0; i < static_cast<int>(pieces.size()); ++i) {
+            const Node& n = pieces[i];
+            if (n.side != side || !available(n, ply)) continue;
+            Bitboard to = targets(n);
+            while (to) {
+                int cell = bitboard::pop_lsb(to);
+                int victim = board[cell];
+                if (victim >= 0 && pieces[victim].immune_ply == ply) continue;
+                Move move{i, cell, false, 0};
+                if (victim >= 0) {
+                    move.order = piece_value(pieces[victim].src->type) * 16 - piece_value(n.src->type) / 100;
+                }
+                out.push_back(move);
+            }
+            if (n.src->jump_ms > 0 && (threatened & bitboard::bit(n.cell))) {
+                out.push_back(Move{i, n.cell, true, piece_value(n.src->type)});
+            }
+        }
+        std::stable_sort(out.begin(), out.end(), [](const Move& a, const Move& b) { return a.order > b.order; });
+    }
+
+    Undo make(const Move& move, int ply) {
+        Undo undo;
+        if (move.piece < 0) return undo;
+        Node& n = pieces[move.piece];
+        undo.from = n.cell;
+        undo.ready_ms = n.ready_ms;
+        undo.immune_ply = n.immune_ply;
+        int start = ply * kPlyMs;
+        if (move.jump) {
+            n.ready_ms = start + n.src->jump_ms;
+            n.immune_ply = ply + 1;
+            return undo;
+        }
+        undo.victim = board[move.to];
+        if (undo.victim >= 0) {
+            Node& v = pieces[undo.victim];
+            v.alive = false;
+            occupied[v.side] &= ~bitboard::bit(move.to);
+        }
+        int dr = move.to / 8 - n.cell / 8, dc = move.to % 8 - n.cell % 8;
+        int cells = std::max(std::abs(dr), std::abs(dc));
+        n.ready_ms = start + cells * n.src->ms_per_cell + n.src->move_cooldown_ms;
+        occupied[n.side] &= ~bitboard::bit(n.cell);
+        occupied[n.side] |= bitboard::bit(move.to);
+        board[n.cell] = -1;
+        board[move.to] = move.piece;
+        n.cell = move.to;
+        return undo;
+    }
+
+    void unmake(const Move& move, const Undo& undo) {
+        if (move.piece < 0) return;
+        Node& n = pieces[move.piece];
+        if (!move.jump) {
+            occupied[n.side] &= ~bitboard::bit(n.cell);
+            occupied[n.side] |= bitboard::bit(undo.from);
+            board[n.cell] = undo.victim;
+            board[undo.from] = move.piece;
+            if (undo.victim >= 0) {
+                Node& v = pieces[undo.victim];
+                v.alive = true;
+                occupied[v.side] |= bitboard::bit(n.cell);
+            }
+            n.cell = undo.from;
+        }
+        n.ready_ms = undo.ready_ms;
+        n.immune_ply = undo.immune_ply;
+    }
+
+    // From 'side's point of view
+    int evaluate(int side) const {
+        int score = 0;
+        for (const auto& n : pieces) {
+            if (!n.alive) continue;
+            int value = piece_value(n.src->type) + placement(n.src->type, n.src->color, n.cell / 8, n.cell % 8);
+            score += n.side == side ? value : -value;
+        }
+        return score;
+    }
+
+    bool king_lost(int side) const {
+        for (const auto& n : pieces) {
+            if (n.side == side && n.src->type == 'K') return !n.alive;
+        }
+        return false;
+    }
+
+    int negamax(int depth, int ply, int alpha, int beta, int side) {
+        if ((++nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            aborted = true;
+        }
+        if (aborted) return 0;
+        if (king_lost(side)) return -kMate + ply;
+        if (depth == 0) return evaluate(side);
+
+        auto& moves = stack[ply];
+        generate(side, ply, moves);
+        int best = -kInfinity;
+        for (const auto& move : moves) {
+            Undo undo = make(move, ply);
+            int score = -negamax(depth - 1, ply + 1, -beta, -alpha, 1 - side);
+            unmake(move, undo);
+            if (aborted) return 0;
+            if (score > best) best = score;
+            if (score > alpha) alpha = score;
+            if (alpha >= beta) break;
+        }
+        return best;
+    }
+};
+}
+
+// ---------------------------------------------------------------------------
+Bot::Bot(char color, BotConfig config, CommandSink sink)
+    : color_(color), config_(config), sink_(std::move(sink)) {
+    if (!config_.inline_search) {
+        worker_ = std::thread([this] { worker_loop(); });
+    }
+}
+
+Bot::~Bot() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool Bot::wants_position(int now_ms) const {
+    if (busy_.load(std::memory_order_acquire)) return false;
+    return !submitted_ || now_ms - last_submit_ms_ >= config_.think_interval_ms;
+}
+
+void Bot::submit(BotPosition position) {
+    submitted_ = true;
+    last_submit_ms_ = position.time_ms;
+    if (config_.inline_search) {
+        think(position);
+        return;
+    }
+    busy_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        position_ = std::move(position);
+        has_position_ = true;
+    }
+    cv_.notify_one();
+}
+
+BotDecision Bot::decide(const BotPosition& position,
+                        std::chrono::steady_clock::time_point deadline, int max_depth) {
+    if (position.promoting) {
+        BotDecision decision;
+        decision.pass = false;
+        decision.command.type = "promote_queen";
+        decision.command.player_id = position.color == 'W' ? 1 : 2;
+        return decision;
+    }
+    Search search(position, deadline);
+    return search.run(max_depth);
+}
+
+Bot::Stats Bot::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+void Bot::worker_loop() {
+    BotPosition position;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || has_position_; });
+            if (stop_) return;
+            std::swap(position, position_);
+            has_position_ = false;
+        }
+
+        think(position);
+        busy_.store(false, std::memory_order_release);
+    }
+}
+
+void Bot::think(const BotPosition& position) {
+    auto start = std::chrono::steady_clock::now();
+    BotDecision decision = decide(position, start + std::chrono::milliseconds(config_.budget_ms),
+                                  config_.max_depth);
+    double think_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!decision.pass) {
+        sink_(decision.command);
+    }
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++stats_.decisions;
+    stats_.moves += decision.pass ? 0 : 1;
+    stats_.nodes += decision.nodes;
+    stats_.last_depth = decision.depth;
+    stats_.last_think_ms = think_ms;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Command.hpp"
+#include "Moves.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// What the bot knows about one piece, copied on the simulation thread
+struct BotPiece {
+    std::string id;
+    char type{'?'};
+    char color{'?'};
+    std::pair<int,int> cell{0, 0};          // where it stands, or where it is heading
+    int ready_ms{0};                        // until it can be commanded (0 = now)
+    std::shared_ptr<const Moves> moves;     // rules of the state it will be commanded in
+    int ms_per_cell{500};                   // move speed
+    int move_cooldown_ms{0};                // long_rest after a move
+    int jump_ms{0};                         // jump plus short_rest
+};
+
+struct BotPosition {
+    int time_ms{0};
+    char color{'W'};                        // side the bot plays
+    bool promoting{false};                  // one of its pawns waits for a piece choice
+    std::vector<BotPiece> pieces;
+};
+
+struct BotDecision {
+    bool pass{true};                        // nothing worth doing
+    Command command;                        // timestamp filled in by the game
+    int score{0};                           // centipawns, bot's point of view
+    int depth{0};                           // deepest completed iteration
+    uint64_t nodes{0};
+};
+
+struct BotConfig {
+    int budget_ms{40};                      // hard limit per decision
+    int think_interval_ms{250};             // game time between decisions
+    int max_depth{8};
+    // Search inside submit(), on the simulation thread. For virtual-clock
+    // games (self-play), where game time would run ahead of a worker.
+    bool inline_search{false};
+};
+
+// ---------------------------------------------------------------------------
+// Computer player for one color. The simulation thread hands it a
+// BotPosition now and then; a worker thread searches it and sends the chosen
+// move/jump through the sink, the same Commands a human produces, which the
+// game validates like any other input. Nothing on the simulation or render
+// threads waits for it.
+//
+// The search is iterative-deepening alpha-beta on a simplified real-time
+// model: every ply is one second in which the side to move commands at most
+// one piece that is ready by then (or passes), a moved piece is busy for its
+// travel time plus long_rest and a jumping one for the jump plus short_rest,
+// and a jumping piece cannot be captured by the reply. It stops at the
+// budget and answers with the best move of the last completed depth.
+// ---------------------------------------------------------------------------
+class Bot {
+public:
+    using CommandSink = std::function<void(Command)>;
+
+    Bot(char color, BotConfig config, CommandSink sink);
+    ~Bot();
+    Bot(const Bot&) = delete;
+    Bot& operator=(const Bot&) = delete;
+
+    char color() const { return color_; }
+
+    // Simulation thread: true when the bot is idle and due for a decision
+    bool wants_position(int now_ms) const;
+    void submit(BotPosition position);
+
+    // The search itself, synchronous; the worker calls it with its budget
+    static BotDecision decide(const BotPosition& position,
+                              std::chrono::steady_clock::time_point deadline, int max_depth);
+
+    struct Stats {
+        uint64_t decisions{0};
+        uint64_t moves{0};
+        uint64_t nodes{0};
+        int last_depth{0};
+        double last_think_ms{0};
+    };
+    Stats stats() const;
+
+private:
+    char color_;
+    BotConfig config_;
+    CommandSink sink_;
+
+    std::atomic<bool> busy_{false};
+    int last_submit_ms_{0};
+    bool submitted_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool has_position_{false};      // guarded by mutex_
+    BotPosition position_;          // guarded by mutex_
+    bool stop_{false};              // guarded by mutex_
+    mutable std::mutex stats_mutex_;
+    Stats stats_;
+    std::thread worker_;
+
+    void worker_loop();
+    void think(const BotPosition& position);
+};
@@ -0,0 +1,183 @@
+#include "CapturePredictor.hpp"
+#include "CaptureRules.hpp"
+#include "Piece.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Times around every half-cell boundary crossing on one axis. The rounding
+// in Board::m_to_cell flips somewhere inside each probe window.
+void add_crossings(double from, double to, double cell_size, int begin_ms, double duration_ms,
+                   int end_ms, std::vector<int>& times) {
+    if (from == to || cell_size <= 0.0 || duration_ms <= 0.0) return;
+    const double lo = std::min(from, to) / cell_size;
+    const double hi = std::max(from, to) / cell_size;
+    for (int k = static_cast<int>(std::floor(lo - 0.5)); k <= static_cast<int>(std::ceil(hi)); ++k) {
+        double boundary = (k + 0.5) * cell_size;
+        double f = (boundary - from) / (to - from);
+        if (f < 0.0 || f > 1.0) continue;
+        double t = begin_ms + f * duration_ms;
+        for (int probe = static_cast<int>(std::floor(t)) - 1; probe <= static_cast<int>(std::ceil(t)) + 1; ++probe) {
+            if (probe > begin_ms && probe < end_ms) times.push_back(probe);
+        }
+    }
+}
+}
+
+// ---------------------------------------------------------------------------
+void CapturePredictor::timeline(const PiecePtr& piece, int now_ms, std::vector<Span>& out) {
+    out.clear();
+    if (!piece || !piece->state || !piece->state->physics) return;
+    const auto& physics = piece->state->physics;
+
+    const MovePhysics* move = physics->is_continuous()
+        ? dynamic_cast<const MovePhysics*>(physics.get()) : nullptr;
+    if (!move) {
+        out.push_back(Span{piece->current_cell(), std::min(physics->start_ms, now_ms), kForever});
+        return;
+    }
+
+    const int begin = move->start_ms;
+    const int end = move->deadline_ms();
+    const double duration_ms = move->get_duration_s() * 1000.0;
+
+    // The cell can only change at a boundary crossing; evaluate just there
+    std::vector<int> times{end};
+    add_crossings(move->start_cell.second, move->end_cell.second, move->board.cell_W_m,
+                  begin, duration_ms, end, times);
+    add_crossings(move->start_cell.first, move->end_cell.first, move->board.cell_H_m,
+                  begin, duration_ms, end, times);
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    Span current{move->cell_at(begin), begin, kForever};
+    for (int t : times) {
+        auto cell = move->cell_at(t);
+        if (cell == current.cell) continue;
+        current.exit_ms = t;
+        out.push_back(current);
+        current = Span{cell, t, kForever};
+    }
+    out.push_back(current); // the piece stays on its destination afterwards
+
+    if (is_leaping(*piece) && out.size() > 2) {
+        out.erase(out.begin() + 1, out.end() - 1);
+    }
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [now_ms](const Span& s) { return s.exit_ms <= now_ms; }),
+              out.end());
+}
+
+bool CapturePredictor::is_leaping(const Piece& piece) {
+    if (!piece.state || !piece.state->physics || !piece.state->physics->is_continuous()) return false;
+    const auto from = piece.state->physics->start_cell;
+    const auto to = piece.state->physics->end_cell;
+    if (std::max(std::abs(to.first - from.first), std::abs(to.second - from.second)) < 2) return false;
+    // The rules of the state the move was issued from (idle, ...)
+    for (const auto& state : piece.states) {
+        if (state->moves && state->moves->is_leap(from, to)) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+void CapturePredictor::invalidate(const PiecePtr& piece) {
+    if (!piece || all_dirty) return;
+    auto inserted = tracks.try_emplace(piece.get());
+    auto& track = inserted.first->second;
+    if (inserted.second) track.order = next_order++;
+    if (track.mark == Mark::Clean) {
+        track.mark = Mark::Dirty;
+        dirty.push_back(piece);
+    }
+}
+
+void CapturePredictor::remove(const PiecePtr& piece) {
+    if (!piece) return;
+    tracks.erase(piece.get());
+    dirty.erase(std::remove(dirty.begin(), dirty.end(), piece), dirty.end());
+}
+
+void CapturePredictor::update(const std::vector<PiecePtr>& pieces, int now_ms) {
+    if (all_dirty) {
+        all_dirty = false;
+        contacts = {};
+        tracks.clear();
+        dirty = pieces;
+        for (const auto& piece : pieces) {
+            auto& track = tracks[piece.get()];
+            track.mark = Mark::Dirty;
+            track.order = next_order++;
+        }
+    }
+    if (dirty.empty()) return;
+
+    for (const auto& piece : dirty) {
+        auto& track = tracks[piece.get()];
+        track.version = next_version++;
+        timeline(piece, now_ms, track.spans);
+    }
+
+    // Each dirty piece against the whole board; a pair of two dirty pieces
+    // is done by the first of them
+    for (const auto& piece : dirty) {
+        auto& track = tracks[piece.get()];
+        for (const auto& other : pieces) {
+            if (other == piece) continue;
+            const auto& other_track = tracks[other.get()];
+            if (other_track.mark == Mark::Done) continue;
+            if (CaptureRules::are_same_team(piece, other)) continue;
+            if (track.order < other_track.order) add_contacts(piece, track, other, other_track, now_ms);
+            else add_contacts(other, other_track, piece, track, now_ms);
+        }
+        track.mark = Mark::Done;
+    }
+    for (const auto& piece : dirty) {
+        tracks[piece.get()].mark = Mark::Clean;
+    }
+    dirty.clear();
+
+    if (contacts.size() >= compact_at) compact();
+}
+
+void CapturePredictor::add_contacts(const PiecePtr& a, const Track& ta, const PiecePtr& b, const Track& tb,
+                                    int now_ms) {
+    for (const auto& x : ta.spans) {
+        for (const auto& y : tb.spans) {
+            if (x.cell != y.cell) continue;
+            int from = std::max(x.enter_ms, y.enter_ms);
+            int to = std::min(x.exit_ms, y.exit_ms);
+            if (from >= to || to <= now_ms) continue;
+            contacts.push(Contact{from, next_seq++, a, b, x.cell, ta.version, tb.version, ta.order, tb.order});
+        }
+    }
+}
+
+bool CapturePredictor::is_current(const Contact& c) const {
+    auto a = tracks.find(c.first.get());
+    auto b = tracks.find(c.second.get());
+    return a != tracks.end() && b != tracks.end() &&
+           a->second.version == c.first_version && b->second.version == c.second_version;
+}
+
+// Superseded contacts far in the future would otherwise pile up
+void CapturePredictor::compact() {
+    std::vector<Contact> live;
+    live.reserve(contacts.size());
+    while (!contacts.empty()) {
+        if (is_current(contacts.top())) live.push_back(contacts.top());
+        contacts.pop();
+    }
+    contacts = decltype(contacts)(Later{}, std::move(live));
+    compact_at = std::max<size_t>(256, contacts.size() * 2);
+}
+
+bool CapturePredictor::pop_due(int now_ms, Contact& out) {
+    while (!contacts.empty() && contacts.top().time_ms <= now_ms) {
+        out = contacts.top();
+        contacts.pop();
+        if (is_current(out)) return true;
+    }
+    return false;
+}
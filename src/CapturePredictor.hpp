@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Common.hpp"
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Piece;
+
+// ---------------------------------------------------------------------------
+// Predicts captures analytically instead of scanning the board every frame.
+// From the current physics of every piece it derives the cells each piece
+// will occupy and when (a moving piece enters/leaves cells at exact
+// milliseconds along its path; a static piece stays put). Every time two
+// opposing pieces share a cell, a contact
+// is scheduled at the exact millisecond the overlap begins. Contacts are
+// resolved in time order with CaptureRules, so the outcome does not depend
+// on the frame rate.
+//
+// A piece's timeline only changes with its state (a command, a transition),
+// so only the pieces marked dirty since the last update are recomputed,
+// together with the pairs they are part of. Their older contacts stay queued
+// and are skipped when they surface.
+// ---------------------------------------------------------------------------
+class CapturePredictor {
+public:
+    using Cell = std::pair<int,int>;
+
+    struct Contact {
+        int time_ms;
+        uint64_t seq;
+        PiecePtr first;
+        PiecePtr second;
+        Cell cell;
+        uint64_t first_version;     // timelines the contact was computed from
+        uint64_t second_version;
+        uint64_t first_order;       // board order of the pair: ties between
+        uint64_t second_order;      // contacts fire in pair order
+    };
+
+    // Cell occupied during [enter_ms, exit_ms)
+    struct Span {
+        Cell cell;
+        int enter_ms;
+        int exit_ms;
+    };
+
+    static constexpr int kForever = std::numeric_limits<int>::max();
+
+    // Recompute every piece on the next update
+    void invalidate() { all_dirty = true; }
+    // 'piece' changed state, or joined the board (promotion)
+    void invalidate(const PiecePtr& piece);
+    // 'piece' left the board
+    void remove(const PiecePtr& piece);
+    bool is_dirty() const { return all_dirty || !dirty.empty(); }
+
+    // Recompute the dirty pieces' timelines and their contacts. 'pieces' is
+    // the board, in the order pairs are listed in
+    void update(const std::vector<PiecePtr>& pieces, int now_ms);
+
+    // Pops the earliest current contact due at or before now_ms
+    bool pop_due(int now_ms, Contact& out);
+
+    size_t pending() const { return contacts.size(); }
+
+    // Cells 'piece' will occupy from now on, assuming no further commands
+    static void timeline(const PiecePtr& piece, int now_ms, std::vector<Span>& out);
+    // On a move its rules let skip the cells in between (a knight's jump):
+    // only the cells it leaves and lands on can see a capture
+    static bool is_leaping(const Piece& piece);
+
+private:
+    struct Later {
+        bool operator()(const Contact& a, const Contact& b) const {
+            if (a.time_ms != b.time_ms) return a.time_ms > b.time_ms;
+            if (a.first_order != b.first_order) return a.first_order > b.first_order;
+            if (a.second_order != b.second_order) return a.second_order > b.second_order;
+            return a.seq > b.seq;
+        }
+    };
+
+    enum class Mark : uint8_t { Clean, Dirty, Done };
+    struct Track {
+        std::vector<Span> spans;
+        uint64_t version{0};
+        uint64_t order{0};          // pieces only leave the board or join at its end,
+                                    // so first-seen order is board order
+        Mark mark{Mark::Clean};
+    };
+
+    std::priority_queue<Contact, std::vector<Contact>, Later> contacts;
+    std::unordered_map<const Piece*, Track> tracks;
+    std::vector<PiecePtr> dirty;
+    bool all_dirty{true};
+    uint64_t next_seq{0};
+    uint64_t next_version{1};
+    uint64_t next_order{0};
+    size_t compact_at{256};         // heap size that triggers dropping stale contacts
+
+    bool is_current(const Contact& c) const;
+    void compact();
+    void add_contacts(const PiecePtr& a, const Track& ta, const PiecePtr& b, const Track& tb, int now_ms);
+};
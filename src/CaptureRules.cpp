@@ -1,15 +1,16 @@
 #include "CaptureRules.hpp"
+#include "Log.hpp"
 #include "Piece.hpp"
 #include "State.hpp"
 #include <memory>
 
 void CaptureRules::print_collision_summary(const std::pair<int,int>& cell, const std::vector<PiecePtr>& pieces) {
-    std::cout << "=== COLLISION DETECTED AT CELL (" << cell.first << "," << cell.second << ") ===" << std::endl;
-    std::cout << "PIECES IN COLLISION:" << std::endl;
+    KFC_DEBUG(Capture, "=== COLLISION DETECTED AT CELL (" << cell.first << "," << cell.second << ") ===");
+    KFC_DEBUG(Capture, "PIECES IN COLLISION:");
     for (size_t k = 0; k < pieces.size(); ++k) {
         auto p = pieces[k];
-        std::cout << "  [" << k << "] " << p->id << " - state: " << p->state->name 
-                  << ", start_ms: " << p->state->physics->start_ms << std::endl;
+        KFC_DEBUG(Capture, "  [" << k << "] " << p->id << " - state: " << p->state->name 
+                  << ", start_ms: " << p->state->physics->start_ms);
     }
 }
 
@@ -21,16 +22,16 @@ bool CaptureRules::are_same_team(PiecePtr piece1, PiecePtr piece2) {
 }
 
 void CaptureRules::print_piece_analysis(PiecePtr piece, int current_game_time) {
-    std::cout << piece->id << ":" << std::endl;
-    std::cout << "  Current state: " << piece->state->name << std::endl;
-    std::cout << "  Physics start_ms: " << piece->state->physics->start_ms << std::endl;
-    std::cout << "  Physics type: " << typeid(*(piece->state->physics)).name() << std::endl;
+    KFC_DEBUG(Capture, piece->id << ":");
+    KFC_DEBUG(Capture, "  Current state: " << piece->state->name);
+    KFC_DEBUG(Capture, "  Physics start_ms: " << piece->state->physics->start_ms);
+    KFC_DEBUG(Capture, "  Physics type: " << typeid(*(piece->state->physics)).name());
     
     if (piece->state->name == "move") {
         auto move_phys = std::dynamic_pointer_cast<MovePhysics>(piece->state->physics);
         if (move_phys) {
-            std::cout << "  Move duration: " << move_phys->get_duration_s() << "s" << std::endl;
-            std::cout << "  Estimated arrival: " << (piece->state->physics->start_ms + (int)(move_phys->get_duration_s() * 1000)) << "ms" << std::endl;
+            KFC_DEBUG(Capture, "  Move duration: " << move_phys->get_duration_s() << "s");
+            KFC_DEBUG(Capture, "  Estimated arrival: " << (piece->state->physics->start_ms + (int)(move_phys->get_duration_s() * 1000)) << "ms");
         }
     }
 }
@@ -52,18 +53,18 @@ std::pair<PiecePtr, PiecePtr> CaptureRules::determine_attacker_and_victim(PieceP
     int piece1_arrival = calculate_arrival_time(piece1);
     int piece2_arrival = calculate_arrival_time(piece2);
     
-    std::cout << "ANALYSIS: " << piece1->id << " (arrival_time=" << piece1_arrival << "ms) vs " 
-              << piece2->id << " (arrival_time=" << piece2_arrival << "ms)" << std::endl;
+    KFC_DEBUG(Capture, "ANALYSIS: " << piece1->id << " (arrival_time=" << piece1_arrival << "ms) vs " 
+              << piece2->id << " (arrival_time=" << piece2_arrival << "ms)");
     
     // מי שמגיע אחרון הוא התוקף
     if (piece1_arrival > piece2_arrival) {
-        std::cout << "ATTACKER: " << piece1->id << " (הגיע " << piece1_arrival 
-                  << "ms) לוכד VICTIM: " << piece2->id << " (היה במקום מ-" << piece2_arrival << "ms)" << std::endl;
+        KFC_DEBUG(Capture, "ATTACKER: " << piece1->id << " (הגיע " << piece1_arrival 
+                  << "ms) לוכד VICTIM: " << piece2->id << " (היה במקום מ-" << piece2_arrival << "ms)");
         return {piece1, piece2}; // {attacker, victim}
     } 
     else if (piece2_arrival > piece1_arrival) {
-        std::cout << "ATTACKER: " << piece2->id << " (הגיע " << piece2_arrival 
-                  << "ms) לוכד VICTIM: " << piece1->id << " (היה במקום מ-" << piece1_arrival << "ms)" << std::endl;
+        KFC_DEBUG(Capture, "ATTACKER: " << piece2->id << " (הגיע " << piece2_arrival 
+                  << "ms) לוכד VICTIM: " << piece1->id << " (היה במקום מ-" << piece1_arrival << "ms)");
         return {piece2, piece1}; // {attacker, victim}
     } 
     else {
@@ -73,22 +74,22 @@ std::pair<PiecePtr, PiecePtr> CaptureRules::determine_attacker_and_victim(PieceP
 }
 
 std::pair<PiecePtr, PiecePtr> CaptureRules::resolve_simultaneous_arrival(PiecePtr piece1, PiecePtr piece2, int arrival_time) {
-    std::cout << "SIMULTANEOUS ARRIVAL: " << piece1->id << " and " << piece2->id 
-              << " both arrived at " << arrival_time << "ms" << std::endl;
-    std::cout << "CHECKING START TIMES: " << piece1->id << " started at " 
+    KFC_DEBUG(Capture, "SIMULTANEOUS ARRIVAL: " << piece1->id << " and " << piece2->id 
+              << " both arrived at " << arrival_time << "ms");
+    KFC_DEBUG(Capture, "CHECKING START TIMES: " << piece1->id << " started at " 
               << piece1->state->physics->start_ms << "ms vs " << piece2->id 
-              << " started at " << piece2->state->physics->start_ms << "ms" << std::endl;
+              << " started at " << piece2->state->physics->start_ms << "ms");
     
     if (piece1->state->physics->start_ms < piece2->state->physics->start_ms) {
-        std::cout << "ATTACKER: " << piece1->id << " (יצא קודם)" << std::endl;
+        KFC_DEBUG(Capture, "ATTACKER: " << piece1->id << " (יצא קודם)");
         return {piece1, piece2};
     } 
     else if (piece2->state->physics->start_ms < piece1->state->physics->start_ms) {
-        std::cout << "ATTACKER: " << piece2->id << " (יצא קודם)" << std::endl;
+        KFC_DEBUG(Capture, "ATTACKER: " << piece2->id << " (יצא קודם)");
         return {piece2, piece1};
     } 
     else {
-        std::cout << "PERFECT TIE: Both pieces started and arrived at exactly the same time - NO CAPTURE" << std::endl;
+        KFC_INFO(Capture, "PERFECT TIE: Both pieces started and arrived at exactly the same time - NO CAPTURE");
         return {nullptr, nullptr}; // אין לכידה
     }
 }
@@ -111,29 +112,29 @@ bool CaptureRules::process_collision_pair(PiecePtr piece1, PiecePtr piece2,
         reported_collisions.find({key2, key1}) == reported_collisions.end()) {
         char team1 = piece1->id[1];
         char team2 = piece2->id[1];
-        std::cout << "COLLISION: " << piece1->id << " (team " << team1 
-                  << ") vs " << piece2->id << " (team " << team2 << ")" << std::endl;
+        KFC_DEBUG(Capture, "COLLISION: " << piece1->id << " (team " << team1 
+                  << ") vs " << piece2->id << " (team " << team2 << ")");
         reported_collisions.insert({key1, key2});
     }
     
     // בדוק אם הם מאותו צוות
     if (are_same_team(piece1, piece2)) {
-        std::cout << "SAME TEAM BLOCKED: " << piece1->id << " and " << piece2->id << " - NO ACTION" << std::endl;
+        KFC_DEBUG(Capture, "SAME TEAM BLOCKED: " << piece1->id << " and " << piece2->id << " - NO ACTION");
         return false;
     }
     
     // ניתוח מפורט ותוקף/קורבן
-    std::cout << "\n--- DETAILED PIECE ANALYSIS ---" << std::endl;
+    KFC_DEBUG(Capture, "--- DETAILED PIECE ANALYSIS ---");
     print_piece_analysis(piece1, current_game_time);
     print_piece_analysis(piece2, current_game_time);
-    std::cout << "Current game time: " << current_game_time << "ms" << std::endl;
-    std::cout << "--- END ANALYSIS ---\n" << std::endl;
+    KFC_DEBUG(Capture, "Current game time: " << current_game_time << "ms");
+    KFC_DEBUG(Capture, "--- END ANALYSIS ---");
     
     auto [attacker, victim] = determine_attacker_and_victim(piece1, piece2);
     
     if (attacker && victim) {
-        std::cout << "COMBAT: " << attacker->id << " fights " << victim->id << std::endl;
-        std::cout << "COMBAT RESULT: " << attacker->id << " wins and captures " << victim->id << std::endl;
+        KFC_DEBUG(Capture, "COMBAT: " << attacker->id << " fights " << victim->id);
+        KFC_INFO(Capture, "COMBAT RESULT: " << attacker->id << " wins and captures " << victim->id);
         already_captured.insert(victim->id);
         capture_callback(victim, attacker);
         return true; // לכידה בוצעה
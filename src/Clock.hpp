@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+// Game time sources. The windowed game reads the steady clock; headless
+// simulation drives a VirtualClock forward by a fixed step every tick so runs
+// are reproducible and not limited to real time.
+// ---------------------------------------------------------------------------
+class IClock {
+public:
+    virtual ~IClock() = default;
+
+    // Milliseconds since the clock's origin (game start)
+    virtual int now_ms() const = 0;
+};
+
+class SteadyClock : public IClock {
+public:
+    SteadyClock() : start_tp(std::chrono::steady_clock::now()) {}
+
+    int now_ms() const override {
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_tp).count());
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_tp;
+};
+
+class VirtualClock : public IClock {
+public:
+    explicit VirtualClock(int start_ms = 0) : current_ms(start_ms) {}
+
+    // Readable from other threads (input stamping); advanced by one
+    int now_ms() const override { return current_ms.load(std::memory_order_acquire); }
+
+    void advance(int step_ms) { current_ms.fetch_add(step_ms, std::memory_order_acq_rel); }
+    void set(int ms) { current_ms.store(ms, std::memory_order_release); }
+
+private:
+    std::atomic<int> current_ms;
+};
+
+using ClockPtr = std::shared_ptr<IClock>;
@@ -0,0 +1,240 @@
+#include "CommandLog.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+const char kMagic[4] = {'K', 'F', 'C', 'R'};
+const uint8_t kVersion = 1;
+
+class Reader {
+public:
+    Reader(const std::vector<uint8_t>& bytes, size_t pos) : bytes(bytes), pos(pos) {}
+
+    bool done() const { return pos >= bytes.size(); }
+
+    uint64_t get() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= bytes.size()) throw std::runtime_error("Command log truncated");
+            uint8_t b = bytes[pos++];
+            value |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        throw std::runtime_error("Command log: bad varint");
+    }
+
+    int64_t get_signed() {
+        uint64_t v = get();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    const std::string& get_text(std::vector<std::string>& table) {
+        uint64_t index = get();
+        if (index == table.size()) {
+            uint64_t length = get();
+            if (length > bytes.size() - pos) throw std::runtime_error("Command log truncated");
+            table.emplace_back(reinterpret_cast<const char*>(bytes.data() + pos), length);
+            pos += length;
+        } else if (index > table.size()) {
+            throw std::runtime_error("Command log: bad string index");
+        }
+        return table[index];
+    }
+
+private:
+    const std::vector<uint8_t>& bytes;
+    size_t pos;
+};
+}
+
+CommandLog::CommandLog() {
+    bytes.insert(bytes.end(), kMagic, kMagic + 4);
+    bytes.push_back(kVersion);
+}
+
+// ---------------------------------------------------------------------------
+void CommandLog::begin_tick(int now_ms) {
+    if (is_finished) throw std::runtime_error("Command log already finished");
+    close_tick();
+    tick_open = true;
+    tick_ms = now_ms;
+}
+
+void CommandLog::add(const Command& cmd) {
+    if (!tick_open) throw std::runtime_error("Command logged outside a tick");
+    tick_commands.push_back(cmd);
+}
+
+void CommandLog::finish(int end_ms, uint64_t checksum) {
+    if (is_finished) return;
+    close_tick();
+    flush_run();
+    put(kEnd);
+    put_signed(end_ms);
+    put(checksum);
+    is_finished = true;
+    final_ms = end_ms;
+    final_checksum = checksum;
+}
+
+void CommandLog::close_tick() {
+    if (!tick_open) return;
+    tick_open = false;
+    ++ticks;
+    int delta = tick_ms - last_written_ms - static_cast<int>(run_count) * run_delta;
+
+    if (tick_commands.empty()) {
+        if (run_count > 0 && delta != run_delta) flush_run();
+        if (run_count == 0) run_delta = tick_ms - last_written_ms;
+        ++run_count;
+        return;
+    }
+
+    flush_run();
+    put(kTick);
+    put_signed(tick_ms - last_written_ms);
+    put(tick_commands.size());
+    for (const auto& cmd : tick_commands) {
+        put_signed(static_cast<int64_t>(cmd.timestamp) - tick_ms);
+        put_text(ids, cmd.piece_id);
+        put_text(types, cmd.type);
+        put(cmd.params.size());
+        for (const auto& p : cmd.params) {
+            put_signed(p.first);
+            put_signed(p.second);
+        }
+        put_signed(cmd.player_id);
+    }
+    commands += tick_commands.size();
+    tick_commands.clear();
+    last_written_ms = tick_ms;
+}
+
+void CommandLog::flush_run() {
+    if (run_count == 0) return;
+    put(kRun);
+    put(run_count);
+    put_signed(run_delta);
+    last_written_ms += static_cast<int>(run_count) * run_delta;
+    run_count = 0;
+}
+
+void CommandLog::put(uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+void CommandLog::put_signed(int64_t value) {
+    put((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void CommandLog::put_text(std::unordered_map<std::string, uint64_t>& table, const std::string& text) {
+    auto it = table.find(text);
+    if (it != table.end()) {
+        put(it->second);
+        return;
+    }
+    uint64_t index = table.size();
+    table.emplace(text, index);
+    put(index);
+    put(text.size());
+    bytes.insert(bytes.end(), text.begin(), text.end());
+}
+
+// ---------------------------------------------------------------------------
+void CommandLog::for_each_tick(const std::function<void(const Tick&)>& visit) const {
+    int end_ms = 0;
+    uint64_t checksum = 0;
+    bool ended = false;
+    decode(visit, &end_ms, &checksum, &ended);
+}
+
+void CommandLog::decode(const std::function<void(const Tick&)>& visit,
+                        int* end_ms, uint64_t* checksum, bool* ended) const {
+    Reader in(bytes, sizeof(kMagic) + 1);
+    std::vector<std::string> id_table, type_table;
+    Tick tick{0, {}};
+    int64_t time = 0;
+
+    while (!in.done()) {
+        switch (in.get()) {
+        case kRun: {
+            uint64_t count = in.get();
+            int64_t delta = in.get_signed();
+            tick.commands.clear();
+            for (uint64_t i = 0; i < count; ++i) {
+                time += delta;
+                tick.time_ms = static_cast<int>(time);
+                visit(tick);
+            }
+            break;
+        }
+        case kTick: {
+            time += in.get_signed();
+            tick.time_ms = static_cast<int>(time);
+            tick.commands.clear();
+            uint64_t n = in.get();
+            for (uint64_t i = 0; i < n; ++i) {
+                Command cmd;
+                cmd.timestamp = static_cast<int>(time + in.get_signed());
+                cmd.piece_id = in.get_text(id_table);
+                cmd.type = in.get_text(type_table);
+                uint64_t params = in.get();
+                for (uint64_t p = 0; p < params; ++p) {
+                    int row = static_cast<int>(in.get_signed());
+                    int col = static_cast<int>(in.get_signed());
+                    cmd.params.emplace_back(row, col);
+                }
+                cmd.player_id = static_cast<int>(in.get_signed());
+                tick.commands.push_back(std::move(cmd));
+            }
+            visit(tick);
+            break;
+        }
+        case kEnd:
+            *end_ms = static_cast<int>(in.get_signed());
+            *checksum = in.get();
+            *ended = true;
+            return;
+        default:
+            throw std::runtime_error("Command log: unknown record");
+        }
+    }
+}
+
+void CommandLog::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot write command log: " + path);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!out) throw std::runtime_error("Cannot write command log: " + path);
+}
+
+CommandLog CommandLog::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot read command log: " + path);
+    CommandLog log;
+    log.bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (log.bytes.size() < sizeof(kMagic) + 1 || std::memcmp(log.bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a command log: " + path);
+    }
+    if (log.bytes[sizeof(kMagic)] != kVersion) {
+        throw std::runtime_error("Unsupported command log version: " + path);
+    }
+    log.scan();
+    return log;
+}
+
+// Counters and the end record of a loaded log; it cannot be appended to
+void CommandLog::scan() {
+    ticks = commands = 0;
+    decode([this](const Tick& tick) {
+        ++ticks;
+        commands += tick.commands.size();
+        tick_ms = tick.time_ms;
+    }, &final_ms, &final_checksum, &is_finished);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Command.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Binary record of a match: every simulation tick time and every Command the
+// game applied, in application order. Piece state changes happen at tick
+// times, so replaying the same ticks with the same commands reproduces the
+// game exactly.
+//
+// Encoding (all integers LEB128 varints, signed ones zigzag):
+//   "KFCR" version
+//   0 count delta                 count ticks without commands, each delta ms
+//                                 after the previous one
+//   1 delta n cmd...              one tick applying n commands
+//   2 end_ms checksum             end of game and final board checksum
+// A command is its timestamp relative to the tick, piece id and type (each
+// interned: an index, followed by the text on first use), its params and
+// player id. A fixed-rate game costs a few bytes per second plus about 6
+// bytes per command.
+// ---------------------------------------------------------------------------
+class CommandLog {
+public:
+    struct Tick {
+        int time_ms;
+        std::vector<Command> commands;  // applied at the start of the tick
+    };
+
+    CommandLog();
+
+    // --- recording ---
+    void begin_tick(int now_ms);
+    void add(const Command& cmd);           // applied in the current tick
+    void finish(int end_ms, uint64_t checksum);
+
+    // --- playback ---
+    // Decode in order; throws std::runtime_error on a malformed log
+    void for_each_tick(const std::function<void(const Tick&)>& visit) const;
+
+    bool finished() const { return is_finished; }
+    int end_ms() const { return final_ms; }
+    uint64_t checksum() const { return final_checksum; }
+    int last_tick_ms() const { return tick_ms; }  // most recent tick recorded or loaded
+    size_t tick_count() const { return ticks; }
+    size_t command_count() const { return commands; }
+    size_t encoded_bytes() const { return bytes.size(); }
+
+    // Throw std::runtime_error on I/O or format errors
+    void save(const std::string& path) const;
+    static CommandLog load(const std::string& path);
+
+private:
+    enum Record : uint8_t { kRun = 0, kTick = 1, kEnd = 2 };
+
+    std::vector<uint8_t> bytes;
+
+    // Recording state: the open tick and the run of empty ticks before it
+    bool tick_open{false};
+    int tick_ms{0};
+    std::vector<Command> tick_commands;
+    int last_written_ms{0};
+    uint64_t run_count{0};
+    int run_delta{0};
+
+    std::unordered_map<std::string, uint64_t> ids;
+    std::unordered_map<std::string, uint64_t> types;
+
+    bool is_finished{false};
+    int final_ms{0};
+    uint64_t final_checksum{0};
+    size_t ticks{0};
+    size_t commands{0};
+
+    void close_tick();
+    void flush_run();
+    void put(uint64_t value);
+    void put_signed(int64_t value);
+    void put_text(std::unordered_map<std::string, uint64_t>& table, const std::string& text);
+    void decode(const std::function<void(const Tick&)>& visit,
+                int* end_ms, uint64_t* checksum, bool* ended) const;
+    void scan();    // rebuild counters and trailer after load
+};
@@ -0,0 +1,65 @@
+#include "Compositor.hpp"
+
+#include "Log.hpp"
+#include <utility>
+
+Compositor::Compositor(ImgFactoryPtr img_factory, std::string background_path, int width, int height)
+    : factory(std::move(img_factory)), background_path(std::move(background_path)), W(width), H(height) {}
+
+const ImgPtr& Compositor::get_background() {
+    if (!background) {
+        background = factory->load(background_path, {W, H});
+        KFC_INFO(Render, "Compositor: background " << background_path << " cached at "
+                  << W << "x" << H);
+    }
+    return background;
+}
+
+// ---------------------------------------------------------------------------
+ImgPtr Compositor::begin_frame() {
+    const auto& bg = get_background();
+    if (!bg) return nullptr;
+    if (!frame) {
+        frame = bg->clone();
+    } else {
+        bg->copy_to(*frame);
+    }
+    return frame;
+}
+
+// ---------------------------------------------------------------------------
+ImgPtr Compositor::start_screen() {
+    if (!start_layer) {
+        const auto& bg = get_background();
+        if (!bg) return nullptr;
+        start_layer = bg->clone();
+        // Draw large "KUNG FU CHESS" title at top center - move more to left
+        start_layer->put_text("KUNG FU CHESS", 300, 200, 4.0);
+        // Draw "Press any key to start" below - move more to left
+        start_layer->put_text("Press any key to start", 400, 300, 2.0);
+    }
+    return start_layer;
+}
+
+ImgPtr Compositor::game_over_screen(const std::string& winner) {
+    auto it = game_over_layers.find(winner);
+    if (it != game_over_layers.end()) return it->second;
+
+    const auto& bg = get_background();
+    if (!bg) return nullptr;
+    auto layer = bg->clone();
+
+    // Draw medal rectangle as trophy
+    layer->draw_rect(860, 120, 200, 120, {0, 215, 255}); // Gold rectangle
+    layer->put_text("TROPHY", 900, 200, 1.5);
+
+    // Draw winner text
+    std::string win_text = (winner == "WHITE") ? "WHITE WINS!" : "BLACK WINS!";
+    layer->put_text(win_text, 650, 350, 5.0);
+
+    // Draw "Press ESC to exit" below
+    layer->put_text("Press ESC to exit", 750, 450, 2.0);
+
+    game_over_layers.emplace(winner, layer);
+    return layer;
+}
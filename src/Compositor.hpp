@@ -0,0 +1,40 @@
+#pragma once
+
+#include "img/Img.hpp"
+#include "img/ImgFactory.hpp"
+#include <map>
+#include <string>
+
+// ---------------------------------------------------------------------------
+// Holds the static layers of the screen, decoded and scaled once: the
+// background, the start screen and the game-over screens (titles baked in).
+// Each frame starts by copying a cached layer into a reused buffer, so there
+// is no JPEG decode or allocation per frame.
+// ---------------------------------------------------------------------------
+class Compositor {
+public:
+    Compositor(ImgFactoryPtr img_factory, std::string background_path,
+               int width = 1920, int height = 1080);
+
+    int width() const { return W; }
+    int height() const { return H; }
+
+    // Reused frame buffer, reset to the background
+    ImgPtr begin_frame();
+
+    // Complete static screens, built on first use
+    ImgPtr start_screen();
+    ImgPtr game_over_screen(const std::string& winner);
+
+private:
+    ImgFactoryPtr factory;
+    std::string background_path;
+    int W, H;
+
+    ImgPtr background;
+    ImgPtr frame;
+    ImgPtr start_layer;
+    std::map<std::string, ImgPtr> game_over_layers;   // by winner
+
+    const ImgPtr& get_background();
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Compile-time typed publish/subscribe. Every event type has its own channel,
+// picked by template argument, so dispatch is a direct call to each handler
+// of that type: no lookup by name, no payload map.
+//
+// Events are post()ed into a batch and delivered together by flush(), in
+// post order, so subscribers never run in the middle of the publisher's
+// work. Per subscription:
+//  - Delivery::Worker runs the handler on the bus's own thread instead of
+//    the flushing one; a slow handler then cannot stall the publisher.
+//  - coalesce = true delivers only the last event of that type in a batch
+//    (one sound for several moves in the same tick).
+// The batch vectors are reused, so steady-state posting does not allocate.
+// ---------------------------------------------------------------------------
+enum class Delivery {
+    Inline,     // on the thread calling flush()
+    Worker      // on the bus's worker thread
+};
+
+template <typename Event>
+class EventChannel {
+public:
+    using Handler = std::function<void(const Event&)>;
+
+    struct Subscriber {
+        Handler handler;
+        bool coalesce;
+    };
+
+    void subscribe(Handler handler, Delivery delivery, bool coalesce) {
+        auto& list = delivery == Delivery::Worker ? worker : inline_handlers;
+        list.push_back({std::move(handler), coalesce});
+    }
+
+    const std::vector<Subscriber>& subscribers(Delivery delivery) const {
+        return delivery == Delivery::Worker ? worker : inline_handlers;
+    }
+
+private:
+    std::vector<Subscriber> inline_handlers;
+    std::vector<Subscriber> worker;
+};
+
+template <typename... Events>
+class EventBus {
+public:
+    using AnyEvent = std::variant<Events...>;
+
+    EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    ~EventBus() {
+        if (!worker_thread.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(worker_mutex);
+            worker_stop = true;
+        }
+        worker_cv.notify_one();
+        worker_thread.join();
+    }
+
+    // Subscribe before events start flowing (not synchronized with flush)
+    template <typename Event, typename Handler>
+    void subscribe(Handler&& handler, Delivery delivery = Delivery::Inline, bool coalesce = false) {
+        std::get<EventChannel<Event>>(channels).subscribe(std::forward<Handler>(handler), delivery, coalesce);
+        if (delivery == Delivery::Worker) {
+            has_worker_subscribers = true;
+            if (!worker_thread.joinable()) {
+                worker_thread = std::thread([this] { worker_loop(); });
+            }
+        }
+    }
+
+    // Queue for the next flush()
+    template <typename Event>
+    void post(Event event) {
+        pending.emplace_back(std::in_place_type<Event>, std::move(event));
+    }
+
+    // post() + flush()
+    template <typename Event>
+    void publish(Event event) {
+        post(std::move(event));
+        flush();
+    }
+
+    // Deliver everything posted so far. Handlers may post; those events are
+    // delivered by the same call.
+    void flush() {
+        while (!pending.empty()) {
+            std::swap(pending, flushing);
+            dispatch(flushing, Delivery::Inline);
+            if (has_worker_subscribers) {
+                {
+                    std::lock_guard<std::mutex> lock(worker_mutex);
+                    worker_queue.insert(worker_queue.end(), flushing.begin(), flushing.end());
+                }
+                worker_cv.notify_one();
+            }
+            flushing.clear();
+        }
+    }
+
+    size_t pending_count() const { return pending.size(); }
+
+private:
+    std::tuple<EventChannel<Events>...> channels;
+    std::vector<AnyEvent> pending;
+    std::vector<AnyEvent> flushing;
+
+    bool has_worker_subscribers{false};
+    std::thread worker_thread;
+    std::mutex worker_mutex;
+    std::condition_variable worker_cv;
+    std::vector<AnyEvent> worker_queue;     // guarded by worker_mutex
+    bool worker_stop{false};
+
+    void dispatch(const std::vector<AnyEvent>& batch, Delivery delivery) const {
+        // Position of the last event of each type, for coalescing subscribers
+        std::array<size_t, sizeof...(Events)> last{};
+        for (size_t i = 0; i < batch.size(); ++i) {
+            last[batch[i].index()] = i;
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            bool superseded = last[batch[i].index()] != i;
+            std::visit([&](const auto& event) {
+                using Event = std::decay_t<decltype(event)>;
+                for (const auto& sub : std::get<EventChannel<Event>>(channels).subscribers(delivery)) {
+                    if (!(sub.coalesce && superseded)) {
+                        sub.handler(event);
+                    }
+                }
+            }, batch[i]);
+        }
+    }
+
+    void worker_loop() {
+        std::vector<AnyEvent> batch;
+        std::unique_lock<std::mutex> lock(worker_mutex);
+        for (;;) {
+            worker_cv.wait(lock, [this] { return worker_stop || !worker_queue.empty(); });
+            if (worker_queue.empty()) {
+                return; // stopping and drained
+            }
+            std::swap(batch, worker_queue);
+            lock.unlock();
+            dispatch(batch, Delivery::Worker);
+            batch.clear();
+            lock.lock();
+        }
+    }
+};
@@ -11,4 +11,9 @@ void EventPublisher::publish(const GameEvent& event) {
             subscriber->onEvent(event);
         }
     }
-}
\ No newline at end of file
+}
+
+bool EventPublisher::has_subscribers(const std::string& eventType) const {
+    auto it = subscribers_.find(eventType);
+    return it != subscribers_.end() && !it->second.empty();
+}
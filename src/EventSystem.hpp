@@ -22,11 +22,13 @@ public:
     virtual void onEvent(const GameEvent& event) = 0;
 };
 
-// Publisher class
+// String-keyed publisher. Game code publishes typed events (GameEvents.hpp);
+// this remains for ISubscriber implementations, fed by bridge_to_legacy()
 class EventPublisher {
 public:
     void subscribe(const std::string& eventType, std::shared_ptr<ISubscriber> subscriber);
     void publish(const GameEvent& event);
+    bool has_subscribers(const std::string& eventType) const;
     
 private:
     std::unordered_map<std::string, std::vector<std::shared_ptr<ISubscriber>>> subscribers_;
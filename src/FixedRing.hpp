@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+// ---------------------------------------------------------------------------
+// Fixed-capacity ring: push_back() is O(1) and, once full, overwrites the
+// oldest element. Indexing and iteration go oldest to newest. Storage is
+// inline; elements are reused in place.
+// ---------------------------------------------------------------------------
+template <typename T, size_t N>
+class FixedRing {
+    static_assert(N > 0, "FixedRing capacity must be positive");
+
+public:
+    void push_back(const T& value) {
+        slots[(first + count) % N] = value;
+        if (count < N) ++count;
+        else first = (first + 1) % N;
+    }
+
+    const T& operator[](size_t i) const { return slots[(first + i) % N]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    void clear() { first = count = 0; }
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const FixedRing* ring, size_t i) : ring(ring), i(i) {}
+        reference operator*() const { return (*ring)[i]; }
+        pointer operator->() const { return &(*ring)[i]; }
+        const_iterator& operator++() { ++i; return *this; }
+        const_iterator operator++(int) { auto prev = *this; ++i; return prev; }
+        bool operator==(const const_iterator& o) const { return i == o.i; }
+        bool operator!=(const const_iterator& o) const { return i != o.i; }
+
+    private:
+        const FixedRing* ring;
+        size_t i;
+    };
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, count}; }
+
+private:
+    std::array<T, N> slots{};
+    size_t first{0};
+    size_t count{0};
+};
@@ -0,0 +1,137 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+// ---------------------------------------------------------------------------
+void FrameProfiler::begin_frame() {
+    if (in_frame) end_frame();
+    in_frame = true;
+    frame_start = last_switch = Clock::now();
+    current.fill(0.0);
+    stack.clear();
+}
+
+void FrameProfiler::end_frame() {
+    if (!in_frame) return;
+    auto now = Clock::now();
+    charge(now);
+    in_frame = false;
+
+    Sample sample{};
+    for (size_t i = 0; i < kPhases; ++i) {
+        sample[i] = static_cast<float>(current[i]);
+    }
+    sample[kPhases] = static_cast<float>(
+        std::chrono::duration<double, std::micro>(now - frame_start).count());
+
+    if (keeping_history && history.size() < kMaxHistory) history.push_back(sample);
+    window[window_pos] = sample;
+    window_pos = (window_pos + 1) % kWindow;
+    window_fill = std::min(window_fill + 1, kWindow);
+}
+
+void FrameProfiler::keep_history(bool on) {
+    keeping_history = on;
+    if (!on) std::vector<Sample>().swap(history);
+}
+
+// Time since the last push/pop belongs to the innermost open phase
+void FrameProfiler::charge(Clock::time_point now) {
+    if (!stack.empty()) {
+        current[static_cast<size_t>(stack.back())] +=
+            std::chrono::duration<double, std::micro>(now - last_switch).count();
+    }
+    last_switch = now;
+}
+
+void FrameProfiler::push(Phase phase) {
+    if (!in_frame) return;
+    charge(Clock::now());
+    stack.push_back(phase);
+    seen[static_cast<size_t>(phase)] = true;
+}
+
+void FrameProfiler::pop() {
+    if (!in_frame || stack.empty()) return;
+    charge(Clock::now());
+    stack.pop_back();
+}
+
+// ---------------------------------------------------------------------------
+FrameProfiler::Stats FrameProfiler::window_stats(size_t column) const {
+    Stats s;
+    if (window_fill == 0) return s;
+    std::array<float, kWindow> values{};
+    double sum = 0;
+    for (size_t i = 0; i < window_fill; ++i) {
+        values[i] = window[i][column];
+        sum += values[i];
+    }
+    std::sort(values.begin(), values.begin() + window_fill);
+    s.min_us = values[0];
+    s.avg_us = sum / window_fill;
+    s.p99_us = values[std::min(window_fill - 1, (window_fill * 99) / 100)];
+    return s;
+}
+
+FrameProfiler::Stats FrameProfiler::stats(Phase phase) const {
+    return window_stats(static_cast<size_t>(phase));
+}
+
+FrameProfiler::Stats FrameProfiler::frame_stats() const {
+    return window_stats(kPhases);
+}
+
+const std::vector<std::string>& FrameProfiler::overlay_lines() {
+    auto now = Clock::now();
+    if (!overlay.empty() && now - overlay_time < std::chrono::milliseconds(500)) return overlay;
+    overlay_time = now;
+    overlay.clear();
+
+    char line[96];
+    auto add = [&](const char* name, const Stats& s) {
+        std::snprintf(line, sizeof(line), "%-13s %7.2f %7.2f %7.2f", name,
+                      s.min_us / 1000.0, s.avg_us / 1000.0, s.p99_us / 1000.0);
+        overlay.emplace_back(line);
+    };
+    std::snprintf(line, sizeof(line), "%-13s %7s %7s %7s", "phase (ms)", "min", "avg", "p99");
+    overlay.emplace_back(line);
+    for (size_t i = 0; i < kPhases; ++i) {
+        if (!seen[i]) continue;
+        add(phase_name(static_cast<Phase>(i)), window_stats(i));
+    }
+    add("frame", frame_stats());
+    return overlay;
+}
+
+bool FrameProfiler::write_csv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "frame,total_us";
+    for (size_t i = 0; i < kPhases; ++i) out << ',' << phase_name(static_cast<Phase>(i)) << "_us";
+    out << '\n';
+    for (size_t f = 0; f < history.size(); ++f) {
+        const auto& s = history[f];
+        out << f << ',' << s[kPhases];
+        for (size_t i = 0; i < kPhases; ++i) out << ',' << s[i];
+        out << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+const char* FrameProfiler::phase_name(Phase phase) {
+    switch (phase) {
+    case Phase::Commands:     return "commands";
+    case Phase::PieceUpdate:  return "piece_update";
+    case Phase::OccupancyMap: return "occupancy_map";
+    case Phase::Promotion:    return "promotion";
+    case Phase::Collisions:   return "collisions";
+    case Phase::Events:       return "events";
+    case Phase::Render:       return "render";
+    case Phase::ScoreOverlay: return "score_overlay";
+    case Phase::Present:      return "present";
+    default:                  return "?";
+    }
+}
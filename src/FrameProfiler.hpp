@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Per-phase frame timing. Phases are measured with ScopedPhase (RAII) and
+// are exclusive: a nested phase pauses its parent, so the phases of a frame
+// add up to the frame. Keeps a rolling window for min/avg/p99, which
+// the game draws as an overlay, and, when asked to, the full per-frame
+// history for CSV export.
+// ---------------------------------------------------------------------------
+class FrameProfiler {
+public:
+    enum class Phase {
+        Commands,       // queued command dispatch
+        PieceUpdate,    // scheduler: physics and state transitions
+        OccupancyMap,   // update_cell2piece_map
+        Promotion,      // promotion scan
+        Collisions,     // resolve_collisions
+        Events,         // end-of-tick event flush
+        Render,         // sprite collection and compositing
+        ScoreOverlay,   // draw_score_and_moves and other text
+        Present,        // show() and waitKeyEx
+        Count
+    };
+    static constexpr size_t kPhases = static_cast<size_t>(Phase::Count);
+    static constexpr size_t kWindow = 240;      // frames in the rolling stats
+
+    struct Stats {
+        double min_us{0};
+        double avg_us{0};
+        double p99_us{0};
+    };
+
+    class ScopedPhase {
+    public:
+        ScopedPhase(FrameProfiler& profiler, Phase phase) : profiler(profiler) { profiler.push(phase); }
+        ~ScopedPhase() { profiler.pop(); }
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+    private:
+        FrameProfiler& profiler;
+    };
+
+    // Frames are delimited by begin_frame(); the previous one is closed first
+    void begin_frame();
+    void end_frame();
+
+    Stats stats(Phase phase) const;
+    Stats frame_stats() const;
+
+    // Per-frame history for write_csv (off by default: ~40 bytes a frame)
+    void keep_history(bool on);
+    size_t frames() const { return history.size(); }   // in the history
+
+    // Text lines for the on-screen overlay, refreshed at most every 500 ms.
+    // Phases never entered are left out.
+    const std::vector<std::string>& overlay_lines();
+
+    // One row per frame: frame,total_us,<phase>_us...
+    bool write_csv(const std::string& path) const;
+
+    static const char* phase_name(Phase phase);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Sample = std::array<float, kPhases + 1>;      // phases..., total (us)
+
+    static constexpr size_t kMaxHistory = 1 << 20;
+
+    bool in_frame{false};
+    Clock::time_point frame_start;
+    Clock::time_point last_switch;
+    std::vector<Phase> stack;
+    std::array<double, kPhases> current{};
+    std::array<bool, kPhases> seen{};
+
+    bool keeping_history{false};
+    std::vector<Sample> history;
+    size_t window_fill{0};
+    size_t window_pos{0};
+    std::array<Sample, kWindow> window{};
+
+    std::vector<std::string> overlay;
+    Clock::time_point overlay_time;
+
+    void push(Phase phase);
+    void pop();
+    void charge(Clock::time_point now);
+    Stats window_stats(size_t column) const;
+};
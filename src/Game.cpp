@@ -1,48 +1,81 @@
 #include "Game.hpp"
+#include "Log.hpp"
 #include "CaptureRules.hpp"
 #include <opencv2/opencv.hpp>
 #include <set>
 #include "Physics.hpp"
+#include <condition_variable>
+
+namespace {
+// Stdin readers still running, including ones left by destroyed games
+std::mutex stdin_mutex;
+std::condition_variable stdin_done;
+int stdin_readers = 0;
+}
 
 // ---------------- Implementation --------------------
-Game::Game(std::vector<PiecePtr> pcs, Board board)
-    : pieces(pcs), board(board) {
+Game::Game(std::vector<PiecePtr> pcs, Board board, std::shared_ptr<PieceFactory> piece_factory, bool with_audio)
+    : pieces(pcs), board(board), piece_factory_(std::move(piece_factory)) {
     validate();
     
     // Initialize event system
-    audioManager_ = std::make_shared<AudioManager>();
     textManager_ = std::make_shared<TextManager>();
     scoreManager_ = std::make_shared<ScoreManager>();
     moveHistoryManager_ = std::make_shared<MoveHistoryManager>();
     
     // Subscribe AudioManager to events
-    eventPublisher_.subscribe("piece_moved", audioManager_);
-    eventPublisher_.subscribe("piece_captured", audioManager_);
-    eventPublisher_.subscribe("game_started", audioManager_);
-    eventPublisher_.subscribe("game_ended", audioManager_);
-    eventPublisher_.subscribe("pawn_promotion", audioManager_);
-    eventPublisher_.subscribe("pawn_promoted", audioManager_);
+    if (with_audio) {
+        audioManager_ = std::make_shared<AudioManager>();
+        audioPublisher_.subscribe("piece_moved", audioManager_);
+        audioPublisher_.subscribe("piece_captured", audioManager_);
+        audioPublisher_.subscribe("game_started", audioManager_);
+        audioPublisher_.subscribe("game_ended", audioManager_);
+        audioPublisher_.subscribe("pawn_promotion", audioManager_);
+        audioPublisher_.subscribe("pawn_promoted", audioManager_);
+    }
     // Subscribe TextManager to events
     eventPublisher_.subscribe("game_started", textManager_);
     eventPublisher_.subscribe("game_playing", textManager_);
     eventPublisher_.subscribe("game_ended", textManager_);
-    // Subscribe ScoreManager and MoveHistoryManager
-    eventPublisher_.subscribe("piece_captured", scoreManager_);
-    eventPublisher_.subscribe("piece_moved", moveHistoryManager_);
+    // Score and move history listen on the typed channels directly
+    events_.subscribe<PieceCaptured>([score = scoreManager_](const PieceCaptured& e) { score->on(e); });
+    events_.subscribe<PieceMoved>([history = moveHistoryManager_](const PieceMoved& e) { history->on(e); });
+    // Audio and text still take string-keyed GameEvents. Sounds are started
+    // on the bus's worker thread, one per event kind per tick.
+    bridge_to_legacy(events_, eventPublisher_);
+    bridge_to_legacy(events_, audioPublisher_, Delivery::Worker, true);
     
     for(const auto & p : pieces) {
         if (p) {
             piece_by_id[p->id] = p;
+            scheduler_.track(p);
+            position_hash_.place(*p);
         }
     }
-    start_tp = std::chrono::steady_clock::now();
+    clock_ = std::make_shared<SteadyClock>();
+    set_profile_csv("");    // frame history only if KFC_PROFILE_CSV asks for an export
     // Initialize position map
+    pos.reset(board.W_cells, board.H_cells);
     update_cell2piece_map();
 }
 
+bool Game::is_quiet() const {
+    return scheduler_.moving_count() == 0 && scheduler_.pending_deadlines() == 0 &&
+           waiting_commands_.empty() && bots_.empty();
+}
+
 int Game::game_time_ms() const {
-    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start_tp).count());
+    // The clock can be swapped while the input thread stamps commands
+    return std::atomic_load(&clock_)->now_ms();
+}
+
+void Game::set_clock(ClockPtr clock) {
+    if (clock) {
+        std::atomic_store(&clock_, clock);
+        if (stdin_feed_) {
+            std::atomic_store(&stdin_feed_->clock, clock);
+        }
+    }
 }
 
 Board Game::clone_board() const {
@@ -71,15 +104,31 @@ void Game::run(int num_iterations, bool is_with_graphics) {
     text_change_time_ = std::chrono::steady_clock::now();
     
     // Publish game start event
-    eventPublisher_.publish(GameEvent("game_started"));
+    events_.publish(GameStarted{});
     
+    const char* record_env = std::getenv("KFC_RECORD");
+    if (!recording_ && (!record_path_.empty() || record_env)) {
+        if (record_path_.empty()) record_path_ = record_env;
+        recording_ = std::make_shared<CommandLog>();
+    }
+    const char* bot_env = std::getenv("KFC_BOT");
+    if (bots_.empty() && bot_env) {
+        std::string colors(bot_env);
+        for (char color : {'W', 'B'}) {
+            if (colors.find(color) != std::string::npos) add_bot(color);
+        }
+    }
+
     running_ = true;
-    start_user_input_thread();
+    start_user_input_thread(!is_with_graphics);
     int start_ms = game_time_ms();
     // Don't call reset - it breaks piece positions
     // for(auto & p : pieces) p->reset(start_ms);
 
     run_game_loop(num_iterations, is_with_graphics);
+    profiler_.end_frame();
+    write_profile_csv();
+    finish_recording();
 
     announce_win();
     
@@ -90,326 +139,753 @@ void Game::run(int num_iterations, bool is_with_graphics) {
         OpenCvImg::close_all_windows();
     } else {
         std::cout << "Press Enter to exit..." << std::endl;
-        std::cin.get();
+        if (input_thread_.joinable()) {
+            // The input thread reads that line and sees the game is over
+            stdin_feed_->open = false;
+            input_thread_.join();
+        } else {
+            wait_for_enter();
+        }
     }
     
     running_ = false;
 }
 
-void Game::start_user_input_thread() {
+Game::~Game() {
+    running_ = false;
+    bots_.clear();
+    if (sim_thread_.joinable()) {
+        sim_thread_.join();
+    }
+    // A reader blocked on stdin cannot be interrupted: it keeps only the
+    // feed, sees it closed and exits after its next line
+    if (stdin_feed_) {
+        stdin_feed_->open = false;
+    }
+    if (input_thread_.joinable()) {
+        input_thread_.detach();
+    }
+}
+
+// In the window keys are read by the render loop (OpenCV only delivers them
+// there); without one, a thread reads commands from stdin
+void Game::start_user_input_thread(bool read_stdin) {
     running_ = true;
+    if (read_stdin && !input_thread_.joinable()) {
+        stdin_feed_ = std::make_shared<StdinFeed>();
+        std::atomic_store(&stdin_feed_->clock, std::atomic_load(&clock_));
+        {
+            std::lock_guard<std::mutex> lock(stdin_mutex);
+            ++stdin_readers;
+        }
+        input_thread_ = std::thread(&Game::input_loop, stdin_feed_);
+    }
+}
+
+void Game::input_loop(std::shared_ptr<StdinFeed> feed) {
+    std::string line;
+    while (feed->open && std::getline(std::cin, line)) {
+        int captured_ms = std::atomic_load(&feed->clock)->now_ms();
+        if (!feed->open) {
+            break;
+        }
+        Command cmd;
+        if (parse_input_line(line, captured_ms, cmd)) {
+            std::lock_guard<std::mutex> lock(feed->mutex);
+            feed->commands.push_back(std::move(cmd));
+            feed->has_commands.store(true, std::memory_order_release);
+        } else if (!line.empty()) {
+            KFC_WARN(Input, "Unrecognized command: " << line);
+        }
+    }
+    std::lock_guard<std::mutex> lock(stdin_mutex);
+    --stdin_readers;
+    stdin_done.notify_all();
+}
+
+void Game::wait_for_enter() {
+    std::unique_lock<std::mutex> lock(stdin_mutex);
+    if (stdin_readers > 0) {
+        stdin_done.wait(lock, [] { return stdin_readers == 0; });
+        return;
+    }
+    lock.unlock();
+    std::cin.get();
+}
+
+// "white_up", "promote_queen", ... or "<piece_id> <type> row,col [row,col]",
+// e.g. "PW_(6,4) move 6,4 4,4"
+bool Game::parse_input_line(const std::string& line, int timestamp, Command& cmd) {
+    std::istringstream in(line);
+    std::vector<std::string> tokens;
+    for (std::string token; in >> token;) {
+        tokens.push_back(token);
+    }
+    if (tokens.empty()) {
+        return false;
+    }
+    if (tokens.size() == 1) {
+        cmd = Command(timestamp, "", tokens[0], {});
+        return true;
+    }
+
+    std::vector<std::pair<int,int>> cells;
+    for (size_t i = 2; i < tokens.size(); ++i) {
+        int row = 0, col = 0;
+        char comma = 0;
+        std::istringstream cell(tokens[i]);
+        if (!(cell >> row >> comma >> col) || comma != ',') {
+            return false;
+        }
+        cells.emplace_back(row, col);
+    }
+    cmd = Command(timestamp, tokens[0], tokens[1], cells);
+    return true;
 }
 
 void Game::run_game_loop(int num_iterations, bool is_with_graphics) {
+    if (!is_with_graphics) {
+        // Headless runs are driven by the virtual clock, not wall time
+        run_simulation(num_iterations, sim_step_ms_);
+        return;
+    }
+
     current_state_ = GameState::STARTING;
     state_start_time_ = std::chrono::steady_clock::now();
-    int it_counter = 0;
     
     // Initialize all pieces first
     int now = game_time_ms();
-    for(size_t i = 0; i < pieces.size(); ++i) {
-        auto& p = pieces[i];
-        try {
-            p->update(now);
-        } catch (const std::exception& e) {
-            // Silent error handling
+    try {
+        scheduler_.advance(now);
+    } catch (const std::exception& e) {
+        // Silent error handling
+    }
+    publish_snapshot(now);
+
+    // The simulation ticks on its own thread at a fixed rate; this thread only
+    // draws the latest snapshot and reads the keyboard (OpenCV windows belong
+    // to the main thread). A slow frame never delays a tick or a capture.
+    sim_thread_ = std::thread([this] { simulation_loop(); });
+    render_loop();
+
+    running_ = false;
+    if (sim_thread_.joinable()) {
+        sim_thread_.join();
+    }
+}
+
+// ---------------- Simulation thread --------------------
+void Game::simulation_loop() {
+    using SteadyTime = std::chrono::steady_clock;
+    const auto step = std::chrono::milliseconds(sim_step_ms_);
+    auto next_tick = SteadyTime::now();
+
+    try {
+        while (running_) {
+            profiler_.begin_frame();
+            update_game_flow();
+            int now = game_time_ms();
+            tick(now);
+            profiler_.end_frame();
+            publish_snapshot(now);
+
+            // Fixed rate; when behind, tick again right away with the real
+            // time instead of bursting to catch up (tick handles any step)
+            next_tick += step;
+            auto wall = SteadyTime::now();
+            if (next_tick < wall) {
+                next_tick = wall;
+            }
+            std::this_thread::sleep_until(next_tick);
         }
+    } catch (const std::exception& e) {
+        KFC_ERROR(Game, "Simulation stopped: " << e.what());
+        running_ = false;
     }
-    
-    while(running_) {
-        if (current_state_ == GameState::STARTING) {
-            if (is_with_graphics) {
-                // Check if 3 seconds have passed to switch to PLAYING
-                auto now_time = std::chrono::steady_clock::now();
-                auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now_time - state_start_time_).count();
-                if (elapsed >= 3) {
-                    current_state_ = GameState::PLAYING;
-                    eventPublisher_.publish(GameEvent("game_playing"));
-                    std::cout << "[DEBUG] Switched to PLAYING state via Publisher" << std::endl;
-                }
-            } else {
-                current_state_ = GameState::PLAYING;
-                eventPublisher_.publish(GameEvent("game_playing"));
+}
+
+// Start banner, win detection and the delayed winner announcement
+void Game::update_game_flow() {
+    if (current_state_ == GameState::STARTING) {
+        // Check if 3 seconds have passed to switch to PLAYING
+        auto now_time = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now_time - state_start_time_).count();
+        if (elapsed >= 3) {
+            current_state_ = GameState::PLAYING;
+            events_.post(GamePlaying{});
+            KFC_DEBUG(Game, "Switched to PLAYING state via Publisher");
+        }
+    }
+    if (current_state_ == GameState::GAME_OVER) {
+        return;
+    }
+
+    // Regular game loop (PLAYING state)
+    if (is_win() && winner_text_.empty()) {
+        KFC_INFO(Game, "*** GAME OVER DETECTED! ***");
+        // DON'T change current_state_ - keep it as PLAYING to maintain board display
+        // Determine winner
+        for (const auto& piece : pieces) {
+            if (piece->id[0] == 'K') {
+                winner_text_ = (piece->id[1] == 'W') ? "WHITE" : "BLACK";
+                KFC_INFO(Game, "*** WINNER SET TO: " << winner_text_ << " ***");
+                break;
             }
         }
         
-        if (current_state_ == GameState::GAME_OVER) {
-            if (is_with_graphics) {
-                draw_game_over_screen(winner_text_);
-                int key = cv::waitKeyEx(30);
-                if (key == 27) { // ESC to exit
-                    break;
-                }
-            } else {
-                break; // Exit immediately in non-graphics mode
-            }
+        // Publish "GAME ENDED" event first
+        events_.post(GameEnded{});
+        
+        // Set timer for winner display
+        text_change_time_ = std::chrono::steady_clock::now();
+        show_winner_first_ = true;
+        
+        KFC_INFO(Game, "*** GAME OVER - BUT STAYING IN PLAYING STATE ***");
+    }
+    
+    // Check if it's time to show winner after "GAME ENDED"
+    if (!winner_text_.empty() && show_winner_first_) {
+        auto now_time = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now_time - text_change_time_).count();
+        if (elapsed >= 3) {
+            // Publish winner event
+            events_.post(GameEnded{winner_text_[0] == 'W' ? 'W' : 'B'});
+            show_winner_first_ = false;
+            KFC_INFO(Game, "*** PUBLISHED WINNER EVENT: " << winner_text_ << " ***");
+        }
+    }
+}
+
+// Copy what the renderer needs into the back snapshot and publish it.
+// Slots are reused, so this does not allocate once the vectors are sized.
+void Game::publish_snapshot(int now_ms) {
+    GameSnapshot& snap = snapshots_.back();
+    snap.seq = ++snapshot_seq_;
+    snap.time_ms = now_ms;
+    snap.state = current_state_;
+
+    snap.pieces.resize(pieces.size());
+    size_t count = 0;
+    for (const auto& piece : pieces) {
+        if (!piece->state || !piece->state->graphics) {
             continue;
         }
-        
-        // Regular game loop (PLAYING state)
-        if (is_win() && winner_text_.empty()) {
-            std::cout << "*** GAME OVER DETECTED! ***" << std::endl;
-            // DON'T change current_state_ - keep it as PLAYING to maintain board display
-            // Determine winner
-            for (const auto& piece : pieces) {
-                if (piece->id[0] == 'K') {
-                    winner_text_ = (piece->id[1] == 'W') ? "WHITE" : "BLACK";
-                    std::cout << "*** WINNER SET TO: " << winner_text_ << " ***" << std::endl;
-                    break;
-                }
-            }
-            
-            // Publish "GAME ENDED" event first
-            eventPublisher_.publish(GameEvent("game_ended"));
-            
-            // Set timer for winner display
-            text_change_time_ = std::chrono::steady_clock::now();
-            show_winner_first_ = true;
-            
-            std::cout << "*** GAME OVER - BUT STAYING IN PLAYING STATE ***" << std::endl;
+        auto& graphics = *piece->state->graphics;
+        graphics.update(now_ms);
+        auto piece_img = graphics.get_img();
+        if (!piece_img) {
+            continue;
         }
-        
-        // Check if it's time to show winner after "GAME ENDED"
-        if (!winner_text_.empty() && show_winner_first_) {
-            auto now_time = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now_time - text_change_time_).count();
-            if (elapsed >= 3) {
-                // Publish winner event
-                std::unordered_map<std::string, std::string> eventData;
-                eventData["winner"] = winner_text_;
-                eventPublisher_.publish(GameEvent("game_ended", eventData));
-                show_winner_first_ = false;
-                std::cout << "*** PUBLISHED WINNER EVENT: " << winner_text_ << " ***" << std::endl;
+
+        auto& view = snap.pieces[count++];
+        view.key = piece.get();
+        view.id = piece->id;
+        view.state = piece->state->name;
+        view.cell = piece->current_cell();
+        view.frame = graphics.current_frame();
+        view.img = std::move(piece_img);
+
+        // Use physics position for moving pieces, cell position for static pieces
+        std::pair<int, int> pos_pix;
+        view.moving = piece->state->name == "move" || piece->state->name == "jump";
+        if (view.moving) {
+            auto pos_m = piece->state->physics->get_pos_m();
+            pos_pix = piece->state->physics->get_pos_pix();
+            // Fallback: if position is (0,0), use cell position instead
+            if (pos_m.first == 0.0 && pos_m.second == 0.0) {
+                pos_pix = board.m_to_pix(board.cell_to_m(view.cell));
             }
+        } else {
+            pos_pix = board.m_to_pix(board.cell_to_m(view.cell));
         }
-        now = game_time_ms();
-        
-        // Update all pieces
-        for(auto & p : pieces) {
-            p->update(now);
+        view.x = pos_pix.first;
+        view.y = pos_pix.second;
+    }
+    snap.pieces.resize(count);
+
+    snap.white_cursor = white_cursor_pos_;
+    snap.black_cursor = black_cursor_pos_;
+    snap.selected = selected_piece_ ? selected_piece_pos_ : std::pair<int,int>{-1, -1};
+    snap.promoting = is_promoting_;
+
+    snap.white_score = scoreManager_->getWhiteScore();
+    snap.black_score = scoreManager_->getBlackScore();
+    snap.white_moves = move_lines(moveHistoryManager_->getWhiteMoves(), moveHistoryManager_->getWhiteMoveCount(),
+                                  white_move_lines_, white_move_lines_count_);
+    snap.black_moves = move_lines(moveHistoryManager_->getBlackMoves(), moveHistoryManager_->getBlackMoveCount(),
+                                  black_move_lines_, black_move_lines_count_);
+    snap.text = textManager_->getCurrentText();
+    snap.winner = winner_text_;
+    snap.winner_shown = !winner_text_.empty() && !show_winner_first_;
+
+    if (show_profiler_) {
+        const auto& lines = profiler_.overlay_lines();
+        if (!profile_lines_ || *profile_lines_ != lines) {
+            profile_lines_ = std::make_shared<const std::vector<std::string>>(lines);
         }
+        snap.profile = profile_lines_;
+    } else {
+        snap.profile.reset();
+    }
 
-        update_cell2piece_map();
-        
-        // Check for pawn promotion after pieces update
-        if (!is_promoting_) {
-            for(auto & piece : pieces) {
-                if (needs_promotion(piece)) {
-                    handle_pawn_promotion(piece);
-                    break; // Handle one promotion at a time
-                }
+    snap.published = std::chrono::steady_clock::now();
+    snapshots_.publish();
+}
+
+// Move list text, rebuilt only when a move was added
+GameSnapshot::Lines Game::move_lines(const MoveHistoryManager::RecentMoves& moves, size_t total,
+                                     GameSnapshot::Lines& cache, size_t& cached_total) {
+    if (cache && cached_total == total) {
+        return cache;
+    }
+    cached_total = total;
+    auto lines = std::make_shared<std::vector<std::string>>();
+    lines->reserve(moves.size());
+    for (const auto& move : moves) {
+        int time_sec = move.timestamp / 1000;
+        lines->push_back(std::to_string(time_sec) + "s " + move.piece_id.substr(0,2) + ": " + move.from_pos + "-" + move.to_pos);
+    }
+    cache = std::move(lines);
+    return cache;
+}
+
+// ---------------- Render thread --------------------
+void Game::render_loop() {
+    while (running_) {
+        render_profiler_.begin_frame();
+        if (snapshots_.fetch()) {
+            // Keep the previous snapshot for interpolation; the copy reuses
+            // the vectors of the one it replaces
+            std::swap(view_prev_, view_);
+            view_ = snapshots_.front();
+        }
+        const GameSnapshot& snap = view_;
+
+        if (snap.state == GameState::GAME_OVER) {
+            draw_game_over_screen(snap.winner);
+            int key = cv::waitKeyEx(kRenderWaitMs);
+            if (key == 27) { // ESC to exit
+                break;
             }
+            continue;
         }
 
-        // Input processing moved to graphics section where OpenCV handles keys
+        render_frame(snap);
 
-        if(is_with_graphics) {
-            // Create a copy of the board to draw pieces on
-            auto display_board = board.clone();
-            
-            int pieces_drawn = 0;
-            int pieces_failed = 0;
-            
-            // Draw all pieces on the board
-            for(const auto& piece : pieces) {
-                auto cell = piece->current_cell();
-                
-                try {
-                    if (!piece->state) {
-                        pieces_failed++;
-                        continue;
-                    }
-                    
-                    if (!piece->state->graphics) {
-                        pieces_failed++;
-                        continue;
-                    }
-                    
-                    // Update graphics before getting image
-                    piece->state->graphics->update(now);
-                    auto piece_img = piece->state->graphics->get_img();
-                    if (!piece_img) {
-                        pieces_failed++;
-                        continue;
-                    }
-                    
+        // Handle input in main loop where window exists
+        int key;
+        {
+            FrameProfiler::ScopedPhase present(render_profiler_, FrameProfiler::Phase::Present);
+            key = cv::waitKeyEx(kRenderWaitMs);
+        }
+        // Stamp before anything else so the command carries the time the
+        // key arrived, not the time the simulation gets to it
+        int captured_ms = game_time_ms();
+        if (key != -1 && !handle_render_key(key, captured_ms, snap)) {
+            break;
+        }
+    }
+    render_profiler_.end_frame();
+}
 
+// Pixel position of a piece between the two latest snapshots
+std::pair<int,int> Game::interpolated_pos(const GameSnapshot::PieceView& piece, size_t index, double alpha) const {
+    if (!piece.moving || alpha >= 1.0) {
+        return {piece.x, piece.y};
+    }
+    const auto& before = view_prev_.pieces;
+    const GameSnapshot::PieceView* prev = nullptr;
+    if (index < before.size() && before[index].key == piece.key) {
+        prev = &before[index];
+    } else {
+        for (const auto& candidate : before) {
+            if (candidate.key == piece.key) {
+                prev = &candidate;
+                break;
+            }
+        }
+    }
+    if (!prev) {
+        return {piece.x, piece.y};
+    }
+    return {static_cast<int>(std::lround(prev->x + (piece.x - prev->x) * alpha)),
+            static_cast<int>(std::lround(prev->y + (piece.y - prev->y) * alpha))};
+}
 
-                    // Use physics position for moving pieces, cell position for static pieces
-                    std::pair<int, int> pos_pix;
-                    if (piece->state->name == "move" || piece->state->name == "jump") {
-                        auto pos_m = piece->state->physics->get_pos_m();
-                        pos_pix = piece->state->physics->get_pos_pix();
-                        // Fallback: if position is (0,0), use cell position instead
-                        if (pos_m.first == 0.0 && pos_m.second == 0.0) {
-                            auto pos_m_fallback = display_board.cell_to_m(cell);
-                            pos_pix = display_board.m_to_pix(pos_m_fallback);
-                        }
-                    } else {
-                        auto pos_m = display_board.cell_to_m(cell);
-                        pos_pix = display_board.m_to_pix(pos_m);
-                    }
+void Game::render_frame(const GameSnapshot& snap) {
+    // Everything below not claimed by a nested phase is compositing
+    FrameProfiler::ScopedPhase render_phase(render_profiler_, FrameProfiler::Phase::Render);
 
-                    piece_img->draw_on(*display_board.img, pos_pix.first, pos_pix.second);
-                    pieces_drawn++;
-                    
-                } catch (const std::exception& e) {
-                    pieces_failed++;
-                }
-            }
-            
-            if (pieces_drawn > 0) {
-                // Draw both cursors
-                int cell_size = 80;
-                
-                // Draw white player cursor (green)
-                auto white_pos_m = display_board.cell_to_m(white_cursor_pos_);
-                auto white_pos_pix = display_board.m_to_pix(white_pos_m);
-                display_board.img->draw_rect(white_pos_pix.first, white_pos_pix.second, 
-                                           cell_size, cell_size, {0, 255, 0}); // Green cursor
-                
-                // Draw black player cursor (red)
-                auto black_pos_m = display_board.cell_to_m(black_cursor_pos_);
-                auto black_pos_pix = display_board.m_to_pix(black_pos_m);
-                display_board.img->draw_rect(black_pos_pix.first, black_pos_pix.second, 
-                                           cell_size, cell_size, {0, 0, 255}); // Red cursor
-                
-                // Draw selected piece border
-                if (selected_piece_) {
-                    auto selected_pos_m = display_board.cell_to_m(selected_piece_pos_);
-                    auto selected_pos_pix = display_board.m_to_pix(selected_pos_m);
-                    display_board.img->draw_rect(selected_pos_pix.first, selected_pos_pix.second, 
-                                               cell_size, cell_size, {255, 0, 0}); // Blue border for selection
-                }
-                
-                // Show promotion message if in promotion mode
-                if (is_promoting_) {
-                    // Promotion message will be shown on background later
-                    std::cout << "[PROMOTION MODE] Waiting for Q/R/B/N key..." << std::endl;
-                }
-                
-              // Load background image
-auto img_factory = std::make_shared<OpenCvImgFactory>();
-int background_width = 1920;
-int background_height = 1080;
-auto background_img = img_factory->load("pieces/background2.jpg", {background_width, background_height});
-
-if (background_img) {
-    // Calculate perfect center position
-    int board_size = 640;
-    int offset_x = (background_width - board_size) / 2 - 200;  // Move left
-    int offset_y = (background_height - board_size) / 2 - 100; // Move up
-    
-    // Debug output
-    static bool debug_printed = false;
-    if (!debug_printed) {
-        std::cout << "Background: " << background_width << "x" << background_height << std::endl;
-        std::cout << "Board size: " << board_size << "x" << board_size << std::endl;
-        std::cout << "Offset: (" << offset_x << ", " << offset_y << ")" << std::endl;
-        debug_printed = true;
+    // Draw one simulation step behind the newest snapshot so moving pieces
+    // can be placed between the last two ticks
+    double alpha = 1.0;
+    if (view_prev_.seq != 0 && snap.seq > view_prev_.seq) {
+        auto span = snap.published - view_prev_.published;
+        auto behind = std::chrono::steady_clock::now() - std::chrono::milliseconds(sim_step_ms_) - view_prev_.published;
+        if (span.count() > 0) {
+            alpha = std::clamp(static_cast<double>(behind.count()) / span.count(), 0.0, 1.0);
+        }
     }
+
+    // Collect sprites and cursors; BoardSurface repaints only what changed
+    const Board& display_board = board;
+    frame_sprites_.clear();
+    frame_markers_.clear();
+    
+    for (size_t i = 0; i < snap.pieces.size(); ++i) {
+        const auto& piece = snap.pieces[i];
+        auto pos_pix = interpolated_pos(piece, i, alpha);
+        frame_sprites_.push_back({piece.key, piece.img, pos_pix.first, pos_pix.second});
+    }
+    if (frame_sprites_.empty()) {
+        return;
+    }
+
+    // Draw both cursors
+    int cell_size = 80;
     
-    display_board.img->draw_on(*background_img, offset_x, offset_y);
-    
-    // Check if game is over and draw winner text on top
-    std::cout << "[DEBUG] Checking game over condition:" << std::endl;
-    std::cout << "[DEBUG] current_state_ = " << (int)current_state_ << " (0=STARTING, 1=PLAYING, 2=GAME_OVER)" << std::endl;
-    std::cout << "[DEBUG] winner_text_ = '" << winner_text_ << "'" << std::endl;
-    std::cout << "[DEBUG] winner_text_.empty() = " << (winner_text_.empty() ? "true" : "false") << std::endl;
-    
-    // Draw score and moves
-    draw_score_and_moves(background_img);
+    // Draw white player cursor (green)
+    auto white_pos_pix = display_board.m_to_pix(display_board.cell_to_m(snap.white_cursor));
+    frame_markers_.push_back({white_pos_pix.first, white_pos_pix.second, 
+                              cell_size, cell_size, {0, 255, 0}}); // Green cursor
+    
+    // Draw black player cursor (red)
+    auto black_pos_pix = display_board.m_to_pix(display_board.cell_to_m(snap.black_cursor));
+    frame_markers_.push_back({black_pos_pix.first, black_pos_pix.second, 
+                              cell_size, cell_size, {0, 0, 255}}); // Red cursor
+    
+    // Draw selected piece border
+    if (snap.selected.first >= 0) {
+        auto selected_pos_pix = display_board.m_to_pix(display_board.cell_to_m(snap.selected));
+        frame_markers_.push_back({selected_pos_pix.first, selected_pos_pix.second, 
+                                  cell_size, cell_size, {255, 0, 0}}); // Blue border for selection
+    }
     
     // Show promotion message if in promotion mode
-    if (is_promoting_) {
-        int promo_x = offset_x + 50;
-        int promo_y = offset_y + 300;
-        background_img->put_text("PAWN PROMOTION!", promo_x, promo_y, 2.0);
-        background_img->put_text("Q=Queen R=Rook B=Bishop N=Knight", promo_x, promo_y + 40, 1.2);
+    if (snap.promoting) {
+        // Promotion message will be shown on background later
+        KFC_DEBUG(Render, "[PROMOTION MODE] Waiting for Q/R/B/N key...");
     }
     
-    // Draw dynamic text from TextManager - positioned above board
-    int text_x = offset_x + 30;   // Move slightly more to the left (440 + 30 = 470)
-    int text_y = offset_y - 30;   // Move down more (220 - 30 = 190)
-    
-    std::string current_text = textManager_->getCurrentText();
-    if (!current_text.empty()) {
-        background_img->put_text(current_text, text_x, text_y, 3.0);
+    const auto& damaged = board_surface_.render(*board.img, frame_sprites_, frame_markers_);
+    auto surface = board_surface_.surface();
+    
+    int background_width = compositor().width();
+    int background_height = compositor().height();
+    // Recompose the whole frame only when the text around the board changed;
+    // otherwise copy just the repainted board rectangles into the last frame
+    std::string overlay = overlay_signature(snap);
+    bool full_frame = !frame_img_ || overlay != last_overlay_ || snap.promoting;
+    if (full_frame) {
+        // Start from the cached background layer
+        frame_img_ = compositor().begin_frame();
+        last_overlay_ = overlay;
+    }
+    auto background_img = frame_img_;
+
+    if (background_img && !full_frame) {
+        int offset_x = (background_width - 640) / 2 - 200;
+        int offset_y = (background_height - 640) / 2 - 100;
+        for (const auto& r : damaged) {
+            surface->copy_region_to(*background_img, r.x, r.y, r.w, r.h, offset_x + r.x, offset_y + r.y);
+        }
+        if (!damaged.empty()) {
+            FrameProfiler::ScopedPhase present(render_profiler_, FrameProfiler::Phase::Present);
+            background_img->show();
+        }
+    } else if (background_img) {
+        // Calculate perfect center position
+        int board_size = 640;
+        int offset_x = (background_width - board_size) / 2 - 200;  // Move left
+        int offset_y = (background_height - board_size) / 2 - 100; // Move up
+        
+        // Debug output
+        static bool debug_printed = false;
+        if (!debug_printed) {
+            KFC_DEBUG(Render, "Background: " << background_width << "x" << background_height);
+            KFC_DEBUG(Render, "Board size: " << board_size << "x" << board_size);
+            KFC_DEBUG(Render, "Offset: (" << offset_x << ", " << offset_y << ")");
+            debug_printed = true;
+        }
+        
+        surface->draw_on(*background_img, offset_x, offset_y);
+        
+        KFC_DEBUG(Render, "state = " << (int)snap.state << " (0=STARTING, 1=PLAYING, 2=GAME_OVER), winner = '" << snap.winner << "'");
+        
+        // Draw score and moves
+        {
+            FrameProfiler::ScopedPhase overlay_phase(render_profiler_, FrameProfiler::Phase::ScoreOverlay);
+            draw_score_and_moves(background_img, snap);
+            if (show_profiler_) {
+                draw_profiler_overlay(background_img, snap);
+            }
+        }
+        
+        // Show promotion message if in promotion mode
+        if (snap.promoting) {
+            int promo_x = offset_x + 50;
+            int promo_y = offset_y + 300;
+            background_img->put_text("PAWN PROMOTION!", promo_x, promo_y, 2.0);
+            background_img->put_text("Q=Queen R=Rook B=Bishop N=Knight", promo_x, promo_y + 40, 1.2);
+        }
+        
+        // Draw dynamic text from TextManager - positioned above board
+        int text_x = offset_x + 30;   // Move slightly more to the left (440 + 30 = 470)
+        int text_y = offset_y - 30;   // Move down more (220 - 30 = 190)
+        
+        if (!snap.text.empty()) {
+            background_img->put_text(snap.text, text_x, text_y, 3.0);
+        }
+        
+        // Show the background with the board on it
+        FrameProfiler::ScopedPhase present(render_profiler_, FrameProfiler::Phase::Present);
+        background_img->show();
+    } else {
+        // Fallback to original display if background fails to load
+        surface->show();
+    }
+}
+
+// Keys become commands stamped with the time they were read and applied by
+// the simulation thread. Returns false when the game should close.
+bool Game::handle_render_key(int key, int captured_ms, const GameSnapshot& snap) {
+    // If game is over and winner is displayed, any key exits
+    if (snap.winner_shown) {
+        std::cout << "Game over! Press any key to exit..." << std::endl;
+        return false;
     }
     
-    // Removed duplicate winner display - using only display_text_ for dynamic text
+    Command cmd(captured_ms, "", "", {});
+    
+    // White player controls (Arrow keys)
+    if (key == 2424832) cmd = Command(captured_ms, "", "white_up", {});    // Up Arrow
+    else if (key == 2555904) cmd = Command(captured_ms, "", "white_down", {});  // Down Arrow
+    else if (key == 2490368) cmd = Command(captured_ms, "", "white_left", {});  // Left Arrow
+    else if (key == 2621440) cmd = Command(captured_ms, "", "white_right", {}); // Right Arrow
+    else if (key == 13) cmd = Command(captured_ms, "", "white_select", {});  // Enter
+    else if (key == 32) cmd = Command(captured_ms, "", "white_jump", {});  // Space
+    // Black player controls (WASD)
+    else if (key == 'w' || key == 'W') cmd = Command(captured_ms, "", "black_up", {});
+    else if (key == 's' || key == 'S') cmd = Command(captured_ms, "", "black_down", {});
+    else if (key == 'a' || key == 'A') cmd = Command(captured_ms, "", "black_left", {});
+    else if (key == 'd' || key == 'D') cmd = Command(captured_ms, "", "black_right", {});
+    else if (key == 'f' || key == 'F') cmd = Command(captured_ms, "", "black_select", {});  // F key
+    else if (key == 'g' || key == 'G') cmd = Command(captured_ms, "", "black_jump", {});  // G key
+    else if (key == 'q' || key == 'Q') cmd = Command(captured_ms, "", "promote_queen", {});
+    else if (key == 'r' || key == 'R') cmd = Command(captured_ms, "", "promote_rook", {});
+    else if (key == 'b' || key == 'B') cmd = Command(captured_ms, "", "promote_bishop", {});
+    else if (key == 'n' || key == 'N') cmd = Command(captured_ms, "", "promote_knight", {});
+    else if (key == 'p' || key == 'P') { // profiler overlay
+        show_profiler_ = !show_profiler_;
+    }
+    else if (key == 27) { // ESC
+        return false;
+    }
     
-    // Show the background with the board on it
-    background_img->show();
-} else {
-    // Fallback to original display if background fails to load
-    display_board.show();
+    if (!cmd.type.empty()) {
+        enqueue_command(cmd);
+    }
+    return true;
 }
 
-                
-                // Handle input in main loop where window exists
-                int key = cv::waitKeyEx(30);
-                if (key != -1) {
-                    // If game is over and winner is displayed, only accept ESC or any key to exit
-                    if (!winner_text_.empty() && !show_winner_first_) {
-                        // Game over - winner is displayed, wait for any key to exit
-                        std::cout << "Game over! Press any key to exit..." << std::endl;
-                        return; // Exit the game
-                    }
-                    
-                    Command cmd(game_time_ms(), "", "", {});
-                    
-                    // White player controls (Arrow keys)
-                    if (key == 2424832) cmd = Command(game_time_ms(), "", "white_up", {});    // Up Arrow
-                    else if (key == 2555904) cmd = Command(game_time_ms(), "", "white_down", {});  // Down Arrow
-                    else if (key == 2490368) cmd = Command(game_time_ms(), "", "white_left", {});  // Left Arrow
-                    else if (key == 2621440) cmd = Command(game_time_ms(), "", "white_right", {}); // Right Arrow
-                    else if (key == 13) cmd = Command(game_time_ms(), "", "white_select", {});  // Enter
-                    else if (key == 32) cmd = Command(game_time_ms(), "", "white_jump", {});  // Space
-                    // Black player controls (WASD)
-                    else if (key == 'w' || key == 'W') cmd = Command(game_time_ms(), "", "black_up", {});
-                    else if (key == 's' || key == 'S') cmd = Command(game_time_ms(), "", "black_down", {});
-                    else if (key == 'a' || key == 'A') cmd = Command(game_time_ms(), "", "black_left", {});
-                    else if (key == 'd' || key == 'D') cmd = Command(game_time_ms(), "", "black_right", {});
-                    else if (key == 'f' || key == 'F') cmd = Command(game_time_ms(), "", "black_select", {});  // F key
-                    else if (key == 'g' || key == 'G') cmd = Command(game_time_ms(), "", "black_jump", {});  // G key
-                    else if (key == 'q' || key == 'Q') cmd = Command(game_time_ms(), "", "promote_queen", {});
-                    else if (key == 'r' || key == 'R') cmd = Command(game_time_ms(), "", "promote_rook", {});
-                    else if (key == 'b' || key == 'B') cmd = Command(game_time_ms(), "", "promote_bishop", {});
-                    else if (key == 'n' || key == 'N') cmd = Command(game_time_ms(), "", "promote_knight", {});
-                    else if (key == 27) { // ESC
-                        return;
-                    }
-                    
-                    if (!cmd.type.empty()) {
-                        process_input(cmd);
-                    }
-                }
-            }
+void Game::run_simulation(int num_ticks, int step_ms) {
+    if (step_ms <= 0) {
+        throw std::invalid_argument("Simulation step must be positive");
+    }
+    auto virtual_clock = use_virtual_clock();
+
+    current_state_ = GameState::PLAYING;
+    events_.post(GamePlaying{});
+
+    scheduler_.advance(game_time_ms());
+    update_cell2piece_map();
+
+    for (int it = 0; num_ticks < 0 || it < num_ticks; ++it) {
+        virtual_clock->advance(step_ms);
+        profiler_.begin_frame();
+        tick(virtual_clock->now_ms());
+        profiler_.end_frame();
+        if (is_win()) {
+            current_state_ = GameState::GAME_OVER;
+            break;
         }
+    }
+}
 
-        resolve_collisions();
+void Game::step_to(int now_ms) {
+    auto virtual_clock = use_virtual_clock();
+    current_state_ = GameState::PLAYING;
+    virtual_clock->set(now_ms);
+    tick(now_ms);
+}
 
-        ++it_counter;
-        // Run indefinitely unless ESC is pressed or win condition is met
-        
-        // Frame pacing handled by cv::waitKey(30)
+// Continue from the current game time so pieces' timers stay consistent
+std::shared_ptr<VirtualClock> Game::use_virtual_clock() {
+    auto virtual_clock = std::dynamic_pointer_cast<VirtualClock>(std::atomic_load(&clock_));
+    if (!virtual_clock) {
+        virtual_clock = std::make_shared<VirtualClock>(game_time_ms());
+        std::atomic_store(&clock_, ClockPtr(virtual_clock));
     }
+    return virtual_clock;
 }
 
-void Game::update_cell2piece_map() {
-    std::lock_guard<std::mutex> lock(positions_mutex_);
-    pos.clear();
-    for(const auto& p : pieces) {
-        if (p && p->state && p->state->physics) {
-            auto cell = p->current_cell();
-            // Validate cell coordinates
-            if (cell.first >= 0 && cell.first < board.W_cells && 
-                cell.second >= 0 && cell.second < board.H_cells) {
-                pos[cell].push_back(p);
+// One simulation step: queued commands, piece physics, occupancy, promotion
+// and captures. Shared by the windowed loop and the headless simulation.
+void Game::tick(int now_ms) {
+    using Phase = FrameProfiler::Phase;
+    if (recording_) {
+        recording_->begin_tick(now_ms);
+    }
+    {
+        FrameProfiler::ScopedPhase phase(profiler_, Phase::Commands);
+        drain_command_queue(now_ms);
+    }
+
+    {
+        // Only moving pieces and expired deadlines are touched
+        FrameProfiler::ScopedPhase phase(profiler_, Phase::PieceUpdate);
+        if (scheduler_.advance(now_ms)) {
+            for (const auto& piece : scheduler_.changed()) {
+                capture_predictor_.invalidate(piece);
+            }
+        }
+    }
+
+    {
+        FrameProfiler::ScopedPhase phase(profiler_, Phase::OccupancyMap);
+        update_cell2piece_map();
+    }
+
+    // Check for pawn promotion after pieces update
+    if (!is_promoting_) {
+        FrameProfiler::ScopedPhase phase(profiler_, Phase::Promotion);
+        for (auto& piece : pieces) {
+            if (needs_promotion(piece)) {
+                handle_pawn_promotion(piece);
+                break; // Handle one promotion at a time
             }
         }
     }
+
+    {
+        FrameProfiler::ScopedPhase phase(profiler_, Phase::Collisions);
+        resolve_collisions(now_ms);
+    }
+
+    feed_bots(now_ms);
+
+    // Subscribers (audio, text, score, history) see this tick's events now,
+    // after the board has settled
+    FrameProfiler::ScopedPhase phase(profiler_, Phase::Events);
+    events_.flush();
+}
+
+// Everything captured so far is collected; commands whose timestamp has been
+// reached are applied in timestamp order (ties in arrival order), so the
+// player who pressed first moves first whatever thread delivered the key.
+void Game::drain_command_queue(int now_ms) {
+    Command incoming;
+    while (command_queue_.try_pop(incoming)) {
+        waiting_commands_.push_back(std::move(incoming));
+    }
+    if (has_overflow_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(overflow_mutex_);
+        for (auto& cmd : command_overflow_) {
+            waiting_commands_.push_back(std::move(cmd));
+        }
+        command_overflow_.clear();
+        has_overflow_.store(false, std::memory_order_release);
+    }
+    if (stdin_feed_ && stdin_feed_->has_commands.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(stdin_feed_->mutex);
+        for (auto& cmd : stdin_feed_->commands) {
+            waiting_commands_.push_back(std::move(cmd));
+        }
+        stdin_feed_->commands.clear();
+        stdin_feed_->has_commands.store(false, std::memory_order_release);
+    }
+    if (waiting_commands_.empty()) {
+        return;
+    }
+
+    // Commands stamped in the future wait for their tick
+    auto due_end = std::stable_partition(waiting_commands_.begin(), waiting_commands_.end(),
+                                         [now_ms](const Command& cmd) { return cmd.timestamp <= now_ms; });
+    pending_commands_.assign(std::make_move_iterator(waiting_commands_.begin()),
+                             std::make_move_iterator(due_end));
+    waiting_commands_.erase(waiting_commands_.begin(), due_end);
+    std::stable_sort(pending_commands_.begin(), pending_commands_.end(),
+                     [](const Command& a, const Command& b) { return a.timestamp < b.timestamp; });
+
+    for (const auto& cmd : pending_commands_) {
+        if (recording_) {
+            recording_->add(cmd);
+        }
+        apply_command(cmd);
+    }
+    pending_commands_.clear();
+}
+
+void Game::finish_recording() {
+    if (!recording_ || recording_->finished()) return;
+    // The recorded state ends at the last tick; the clock may have moved on
+    int end_ms = recording_->last_tick_ms();
+    recording_->finish(end_ms, position_hash_.at(end_ms));
+    KFC_INFO(Game, "Recording: " << recording_->tick_count() << " ticks, " << recording_->command_count()
+             << " commands, " << recording_->encoded_bytes() << " bytes");
+    if (record_path_.empty()) return;
+    try {
+        recording_->save(record_path_);
+        KFC_INFO(Game, "Recording saved to " << record_path_);
+    } catch (const std::exception& e) {
+        KFC_WARN(Game, e.what());
+    }
+}
+
+uint64_t Game::board_checksum() const {
+    return position_hash_.at(game_time_ms());
+}
+
+void Game::apply_command(const Command& cmd) {
+    // Player controls (cursor/select/promote) carry no piece id
+    if (cmd.piece_id.empty()) {
+        process_input(cmd);
+        return;
+    }
+
+    auto piece = find_piece_by_id(cmd.piece_id);
+    if (!piece || !piece->state) {
+        return;
+    }
+
+    if (cmd.type == "move") {
+        if (cmd.params.size() < 2 || !is_move_valid(piece, cmd.params[0], cmd.params[1])) {
+            return;
+        }
+        dispatch_to_piece(piece, cmd);
+        events_.post(PieceMoved{piece->id, cmd.params[0], cmd.params[1], cmd.timestamp});
+    } else if (cmd.type == "jump") {
+        // The jump state takes its cell from the command: any other cell
+        // would teleport the piece there
+        if (cmd.params.empty() || !is_jump_valid(piece, cmd.params[0])) {
+            return;
+        }
+        dispatch_to_piece(piece, cmd);
+    } else {
+        dispatch_to_piece(piece, cmd);
+    }
+}
+
+void Game::dispatch_to_piece(const PiecePtr& piece, const Command& cmd) {
+    piece->on_command(cmd, pos);
+    scheduler_.track(piece);
+    capture_predictor_.invalidate(piece);
+}
+
+void Game::update_cell2piece_map() {
+    std::lock_guard<std::mutex> lock(positions_mutex_);
+    // Only pieces whose cell changed since the last call are relocated
+    pos.sync(pieces);
 }
 
 void Game::process_input(const Command& cmd) {
@@ -434,19 +910,17 @@ void Game::process_input(const Command& cmd) {
     }
     else if (cmd.type == "white_select") {
         cursor_pos_ = white_cursor_pos_;
-        // Use original selection logic
-        update_cell2piece_map();
         if (selected_piece_ == nullptr) {
-            auto cell_pieces_it = pos.find(cursor_pos_);
-            if (cell_pieces_it != pos.end() && !cell_pieces_it->second.empty()) {
-                auto piece = cell_pieces_it->second[0];
+            const auto& cell_pieces = pos.at(cursor_pos_);
+            if (!cell_pieces.empty()) {
+                auto piece = cell_pieces[0];
                 // Allow selection but show message about color
                 selected_piece_ = piece;
                 selected_piece_pos_ = cursor_pos_;
                 if (piece->id.length() >= 2 && piece->id[1] == 'W') {
-                    std::cout << "White player selected: " << piece->id << std::endl;
+                    KFC_INFO(Input, "White player selected: " << piece->id);
                 } else if (piece->id.length() >= 2) {
-                    std::cout << "White player selected black piece: " << piece->id << " (not recommended)" << std::endl;
+                    KFC_INFO(Input, "White player selected black piece: " << piece->id << " (not recommended)");
                 }
             }
         } else if (cursor_pos_ == selected_piece_pos_) {
@@ -456,7 +930,7 @@ void Game::process_input(const Command& cmd) {
             // Check if white player can move this piece
             bool can_move = true;
             if (selected_piece_->id.length() >= 2 && selected_piece_->id[1] != 'W') {
-                std::cout << "White player cannot move black piece: " << selected_piece_->id << std::endl;
+                KFC_INFO(Input, "White player cannot move black piece: " << selected_piece_->id);
                 can_move = false;
             }
             
@@ -467,14 +941,8 @@ void Game::process_input(const Command& cmd) {
                     if (piece_it != piece_by_id.end()) {
                         auto piece = piece_it->second;
                         if (piece && piece->state) {
-                            update_cell2piece_map();
-                            piece->on_command(move_cmd, pos);
-                            std::unordered_map<std::string, std::string> eventData;
-                            eventData["piece_id"] = selected_piece_->id;
-                            eventData["from"] = std::to_string(selected_piece_pos_.first) + "," + std::to_string(selected_piece_pos_.second);
-                            eventData["to"] = std::to_string(cursor_pos_.first) + "," + std::to_string(cursor_pos_.second);
-                            eventData["timestamp"] = std::to_string(game_time_ms());
-                            eventPublisher_.publish(GameEvent("piece_moved", eventData));
+                            dispatch_to_piece(piece, move_cmd);
+                            events_.post(PieceMoved{selected_piece_->id, selected_piece_pos_, cursor_pos_, cmd.timestamp});
                         }
                     }
                 } catch (const std::exception& e) {}
@@ -490,9 +958,8 @@ void Game::process_input(const Command& cmd) {
             auto piece_it = piece_by_id.find(jump_cmd.piece_id);
             if (piece_it != piece_by_id.end()) {
                 auto piece = piece_it->second;
-                if (piece && piece->state) {
-                    update_cell2piece_map();
-                    piece->on_command(jump_cmd, pos);
+                if (is_jump_valid(piece, selected_piece_pos_)) {
+                    dispatch_to_piece(piece, jump_cmd);
                 }
             }
             selected_piece_ = nullptr;
@@ -518,19 +985,17 @@ void Game::process_input(const Command& cmd) {
     }
     else if (cmd.type == "black_select") {
         cursor_pos_ = black_cursor_pos_;
-        // Use original selection logic
-        update_cell2piece_map();
         if (selected_piece_ == nullptr) {
-            auto cell_pieces_it = pos.find(cursor_pos_);
-            if (cell_pieces_it != pos.end() && !cell_pieces_it->second.empty()) {
-                auto piece = cell_pieces_it->second[0];
+            const auto& cell_pieces = pos.at(cursor_pos_);
+            if (!cell_pieces.empty()) {
+                auto piece = cell_pieces[0];
                 // Allow selection but show message about color
                 selected_piece_ = piece;
                 selected_piece_pos_ = cursor_pos_;
                 if (piece->id.length() >= 2 && piece->id[1] == 'B') {
-                    std::cout << "Black player selected: " << piece->id << std::endl;
+                    KFC_INFO(Input, "Black player selected: " << piece->id);
                 } else if (piece->id.length() >= 2) {
-                    std::cout << "Black player selected white piece: " << piece->id << " (not recommended)" << std::endl;
+                    KFC_INFO(Input, "Black player selected white piece: " << piece->id << " (not recommended)");
                 }
             }
         } else if (cursor_pos_ == selected_piece_pos_) {
@@ -540,7 +1005,7 @@ void Game::process_input(const Command& cmd) {
             // Check if black player can move this piece
             bool can_move = true;
             if (selected_piece_->id.length() >= 2 && selected_piece_->id[1] != 'B') {
-                std::cout << "Black player cannot move white piece: " << selected_piece_->id << std::endl;
+                KFC_INFO(Input, "Black player cannot move white piece: " << selected_piece_->id);
                 can_move = false;
             }
             
@@ -551,14 +1016,8 @@ void Game::process_input(const Command& cmd) {
                     if (piece_it != piece_by_id.end()) {
                         auto piece = piece_it->second;
                         if (piece && piece->state) {
-                            update_cell2piece_map();
-                            piece->on_command(move_cmd, pos);
-                            std::unordered_map<std::string, std::string> eventData;
-                            eventData["piece_id"] = selected_piece_->id;
-                            eventData["from"] = std::to_string(selected_piece_pos_.first) + "," + std::to_string(selected_piece_pos_.second);
-                            eventData["to"] = std::to_string(cursor_pos_.first) + "," + std::to_string(cursor_pos_.second);
-                            eventData["timestamp"] = std::to_string(game_time_ms());
-                            eventPublisher_.publish(GameEvent("piece_moved", eventData));
+                            dispatch_to_piece(piece, move_cmd);
+                            events_.post(PieceMoved{selected_piece_->id, selected_piece_pos_, cursor_pos_, cmd.timestamp});
                         }
                     }
                 } catch (const std::exception& e) {}
@@ -574,9 +1033,8 @@ void Game::process_input(const Command& cmd) {
             auto piece_it = piece_by_id.find(jump_cmd.piece_id);
             if (piece_it != piece_by_id.end()) {
                 auto piece = piece_it->second;
-                if (piece && piece->state) {
-                    update_cell2piece_map();
-                    piece->on_command(jump_cmd, pos);
+                if (is_jump_valid(piece, selected_piece_pos_)) {
+                    dispatch_to_piece(piece, jump_cmd);
                 }
             }
             selected_piece_ = nullptr;
@@ -589,15 +1047,12 @@ void Game::process_input(const Command& cmd) {
     else if (cmd.type == "left") move_cursor(-1, 0);
     else if (cmd.type == "right") move_cursor(1, 0);
     else if (cmd.type == "select") {
-        // Update position map before accessing it
-        update_cell2piece_map();
-        
         // Enhanced selection logic from movement-logic branch
         if (selected_piece_ == nullptr) {
             // First press - pick up piece under cursor (any color for legacy support)
-            auto cell_pieces_it = pos.find(cursor_pos_);
-            if (cell_pieces_it != pos.end() && !cell_pieces_it->second.empty()) {
-                selected_piece_ = cell_pieces_it->second[0];
+            const auto& cell_pieces = pos.at(cursor_pos_);
+            if (!cell_pieces.empty()) {
+                selected_piece_ = cell_pieces[0];
                 selected_piece_pos_ = cursor_pos_;
             }
         } else if (cursor_pos_ == selected_piece_pos_) {
@@ -615,17 +1070,10 @@ void Game::process_input(const Command& cmd) {
                     if (piece_it != piece_by_id.end()) {
                         auto piece = piece_it->second;
                         if (piece && piece->state) {
-                            // Update position map again before passing to piece
-                            update_cell2piece_map();
-                            piece->on_command(move_cmd, pos);
+                            dispatch_to_piece(piece, move_cmd);
                             
                             // Publish move event
-                            std::unordered_map<std::string, std::string> eventData;
-                            eventData["piece_id"] = selected_piece_->id;
-                            eventData["from"] = std::to_string(selected_piece_pos_.first) + "," + std::to_string(selected_piece_pos_.second);
-                            eventData["to"] = std::to_string(cursor_pos_.first) + "," + std::to_string(cursor_pos_.second);
-                            eventData["timestamp"] = std::to_string(game_time_ms());
-                            eventPublisher_.publish(GameEvent("piece_moved", eventData));
+                            events_.post(PieceMoved{selected_piece_->id, selected_piece_pos_, cursor_pos_, cmd.timestamp});
                         }
                     }
                 } catch (const std::exception& e) {
@@ -647,9 +1095,8 @@ void Game::process_input(const Command& cmd) {
             auto piece_it = piece_by_id.find(jump_cmd.piece_id);
             if (piece_it != piece_by_id.end()) {
                 auto piece = piece_it->second;
-                if (piece && piece->state) {
-                    update_cell2piece_map();
-                    piece->on_command(jump_cmd, pos);
+                if (is_jump_valid(piece, selected_piece_pos_)) {
+                    dispatch_to_piece(piece, jump_cmd);
                 }
             }
             
@@ -679,12 +1126,19 @@ void Game::process_input(const Command& cmd) {
                     pieces.erase(it);
                 }
                 piece_by_id.erase(promoting_pawn_->id);
+                scheduler_.untrack(promoting_pawn_);
+                position_hash_.remove(*promoting_pawn_);
+                capture_predictor_.remove(promoting_pawn_);
                 
                 // Add new piece
                 pieces.push_back(new_piece);
                 piece_by_id[new_piece->id] = new_piece;
+                scheduler_.track(new_piece);
+                position_hash_.place(*new_piece);
+                capture_predictor_.invalidate(new_piece);
                 
-                std::cout << "Pawn promoted to " << piece_type << "!" << std::endl;
+                KFC_INFO(Game, "Pawn promoted to " << piece_type << "!");
+                events_.post(PawnPromoted{promoting_pawn_->id, new_piece->id});
                 
                 // Reset promotion state
                 promoting_pawn_ = nullptr;
@@ -750,11 +1204,11 @@ void Game::draw_dual_cursors(Board& display_board) {
     }
 }
 
-void Game::resolve_collisions() {
-    check_captures();
+void Game::resolve_collisions(int now_ms) {
+    check_captures(now_ms);
 }
 
-void Game::announce_win() const {
+void Game::announce_win() {
     // Find remaining kings to determine winner
     std::vector<PiecePtr> remaining_kings;
     for (const auto& piece : pieces) {
@@ -774,19 +1228,14 @@ void Game::announce_win() const {
         std::cout << std::string(50, '=') << "\n" << std::endl;
         
         // Publish game end event
-        std::unordered_map<std::string, std::string> eventData;
-        eventData["winner"] = winner_name;
-        eventData["winner_color"] = std::string(1, winner_color);
-        const_cast<Game*>(this)->eventPublisher_.publish(GameEvent("game_ended", eventData));
+        events_.publish(GameEnded{winner_color});
     } else if (remaining_kings.size() == 0) {
         std::cout << "\n" << std::string(50, '=') << std::endl;
         std::cout << "💥 DRAW! Both kings were captured! 💥" << std::endl;
         std::cout << std::string(50, '=') << "\n" << std::endl;
         
         // Publish draw event
-        std::unordered_map<std::string, std::string> eventData;
-        eventData["result"] = "DRAW";
-        const_cast<Game*>(this)->eventPublisher_.publish(GameEvent("game_ended", eventData));
+        events_.publish(GameEnded{0, true});
     }
 }
 
@@ -813,9 +1262,13 @@ bool Game::is_win() const {
 
 
 void Game::enqueue_command(const Command& cmd) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    user_input_queue.push(cmd);
-    cv_.notify_one();
+    if (command_queue_.try_push(cmd)) {
+        return;
+    }
+    // Ring full (the simulation is not draining): keep the command anyway
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    command_overflow_.push_back(cmd);
+    has_overflow_.store(true, std::memory_order_release);
 }
 
 void Game::handle_mouse_click(int x, int y) {
@@ -847,9 +1300,9 @@ void Game::handle_key_press(int key) {
 }
 
 void Game::select_piece_at(int x, int y) {
-    auto cell_pieces_it = pos.find({x, y});
-    if (cell_pieces_it != pos.end() && !cell_pieces_it->second.empty()) {
-        selected_piece_ = cell_pieces_it->second[0];
+    const auto& cell_pieces = pos.at({x, y});
+    if (!cell_pieces.empty()) {
+        selected_piece_ = cell_pieces[0];
         cursor_pos_ = {x, y};
         is_selecting_target_ = true;
     }
@@ -880,81 +1333,74 @@ PiecePtr Game::find_piece_by_id(const std::string& id) {
     return (it != piece_by_id.end()) ? it->second : nullptr;
 }
 
-void Game::check_captures() {
-    // Create a copy of the position map to avoid iterator invalidation
-    auto pos_copy = pos;
-    
-    static std::set<std::string> already_captured; // Keep track globally
-    static std::set<std::pair<std::string, std::string>> reported_collisions; // Track reported collisions
-    
-    for (const auto& [cell, pieces_at_cell] : pos_copy) {
-        if (pieces_at_cell.size() > 1) {
-            CaptureRules::print_collision_summary(cell, pieces_at_cell);
-            
-            // בדוק כל זוג חתיכות
-            for (size_t i = 0; i < pieces_at_cell.size(); ++i) {
-                for (size_t j = i + 1; j < pieces_at_cell.size(); ++j) {
-                    auto piece1 = pieces_at_cell[i];
-                    auto piece2 = pieces_at_cell[j];
-                    
-                    // Validate pieces before processing
-                    if (piece1 && piece2 && piece1->state && piece2->state && 
-                        piece1->id.length() >= 2 && piece2->id.length() >= 2) {
-                        
-                        // Enhanced capture callback with Knight logic
-                        auto capture_callback = [this, cell](PiecePtr captured, PiecePtr captor) {
-                            // Skip capture if knight is not at its target destination
-                            if (captor->id.size() > 0 && captor->id[0] == 'N' && 
-                                captor->state->physics->end_cell != cell) {
-                                return; // Knight doesn't capture unless at target
-                            }
-                            this->capture_piece(captured, captor);
-                        };
-                        
-                        if (CaptureRules::process_collision_pair(piece1, piece2, already_captured, 
-                                                                     reported_collisions, game_time_ms(), 
-                                                                     capture_callback)) {
-                            return; // Exit after first capture
-                        }
-                    }
-                }
+void Game::check_captures(int now) {
+    if (capture_predictor_.is_dirty()) {
+        capture_predictor_.update(pieces, now);
+    }
+
+    // Contacts fire in the order they happen, however long the tick was
+    CapturePredictor::Contact contact;
+    while (capture_predictor_.pop_due(now, contact)) {
+        auto piece1 = contact.first;
+        auto piece2 = contact.second;
+        if (find_piece_by_id(piece1->id) != piece1 || find_piece_by_id(piece2->id) != piece2) {
+            continue; // captured earlier in this tick
+        }
+        const auto cell = contact.cell;
+        CaptureRules::print_collision_summary(cell, {piece1, piece2});
+        
+        // Enhanced capture callback with Knight logic
+        auto capture_callback = [this, cell](PiecePtr captured, PiecePtr captor) {
+            // A leaping piece (knight) only captures where it lands
+            if (CapturePredictor::is_leaping(*captor) && captor->state->physics->end_cell != cell) {
+                return;
+            }
+            this->capture_piece(captured, captor);
+        };
+        
+        if (CaptureRules::process_collision_pair(piece1, piece2, already_captured_, 
+                                                 reported_collisions_, contact.time_ms, 
+                                                 capture_callback)) {
+            if (is_win()) return;
+            // Contacts of the captured piece are dropped as they surface;
+            // anything else that changed is recomputed
+            if (capture_predictor_.is_dirty()) {
+                capture_predictor_.update(pieces, now);
             }
         }
     }
 }
 
 void Game::capture_piece(PiecePtr captured, PiecePtr captor) {
-    std::cout << "capture_piece CALLED: " << (captured ? captured->id : "NULL") 
-              << " captured by " << (captor ? captor->id : "NULL") << std::endl;
+    KFC_DEBUG(Capture, "capture_piece CALLED: " << (captured ? captured->id : "NULL") 
+              << " captured by " << (captor ? captor->id : "NULL"));
     
     if (captured && captor) {
         // Remove the captured piece first
         pieces.erase(std::remove(pieces.begin(), pieces.end(), captured), pieces.end());
         piece_by_id.erase(captured->id);
+        scheduler_.untrack(captured);
+        position_hash_.remove(*captured);
+        capture_predictor_.remove(captured);
         update_cell2piece_map();
          // אחרי update_cell2piece_map() – בודקים אם נשארו פחות משני מלכים
     if (is_win()) {
         // בונים נתוני אירוע סיום
-        std::unordered_map<std::string, std::string> endData;
+        GameEnded ended;
         if (!pieces.empty()) {
-            char winner_color = pieces[0]->id[1];
-            endData["winner"] = (winner_color == 'W' ? "WHITE" : "BLACK");
-            endData["winner_color"] = std::string(1, winner_color);
+            ended.winner = pieces[0]->id[1];
         } else {
-            endData["result"] = "DRAW";
+            ended.draw = true;
         }
         // שולחים אירוע סיום ומשמיעים את הצליל המתאים
-        eventPublisher_.publish(GameEvent("game_ended", endData));
+        events_.post(ended);
         // DON'T call announce_win() here - it will be called later in run()
         // DON'T set running_ = false here - let the main loop handle game over state
         return;  // מחזירים כדי לא לפרסם את אירוע ה‑capture הרגיל
     }
 
             // Normal capture - play capture sound
-            std::unordered_map<std::string, std::string> eventData;
-            eventData["captured"] = captured->id;
-            eventData["captor"] = captor->id;
-            eventPublisher_.publish(GameEvent("piece_captured", eventData));
+            events_.post(PieceCaptured{captured->id, captor->id});
         }
     }
 
@@ -965,20 +1411,15 @@ std::string Game::get_position_key(int x, int y) {
 
 bool Game::is_move_valid(PiecePtr piece, const std::pair<int,int>& from, const std::pair<int,int>& to) {
     if (!piece || !piece->state || !piece->state->moves) {
-        std::cout << "MOVE_VALIDATION: Invalid piece or state" << std::endl;
+        KFC_DEBUG(Game, "MOVE_VALIDATION: Invalid piece or state");
         return false;
     }
     
-    std::cout << "MOVE_VALIDATION: " << piece->id << " מנסה לזוז מ-(" << from.first << "," << from.second 
-              << ") ל-(" << to.first << "," << to.second << ")" << std::endl;
+    KFC_DEBUG(Game, "MOVE_VALIDATION: " << piece->id << " מנסה לזוז מ-(" << from.first << "," << from.second 
+              << ") ל-(" << to.first << "," << to.second << ")");
     
-    // Check if piece can move (not in rest state)
-    if (piece->state->name == "long_rest" || piece->state->name == "short_rest") {
-        return false;
-    }
-    
-    // Check if piece is currently moving
-    if (piece->state->name == "move" || piece->state->name == "jump") {
+    // Check if piece can move (not resting, moving or jumping)
+    if (!is_ready_to_move(piece)) {
         return false;
     }
     
@@ -999,58 +1440,211 @@ bool Game::is_move_valid(PiecePtr piece, const std::pair<int,int>& from, const s
         return false;
     }
     
-    // Update position map to ensure accuracy
-    update_cell2piece_map();
-    
     // Check if destination has piece of same color
-    auto dest_it = pos.find(to);
-    if (dest_it != pos.end() && !dest_it->second.empty()) {
-        auto dest_piece = dest_it->second[0];
+    const auto& dest_pieces = pos.at(to);
+    if (!dest_pieces.empty()) {
+        auto dest_piece = dest_pieces[0];
         if (are_same_color(piece, dest_piece)) {
             return false;
         }
     }
     
-    // Create set of occupied cells for path checking
-    std::unordered_set<std::pair<int,int>, PairHash> occupied_cells;
-    for (const auto& [cell, pieces_at_cell] : pos) {
-        if (!pieces_at_cell.empty()) {
-            occupied_cells.insert(cell);
-            std::cout << "OCCUPIED CELL: (" << cell.first << "," << cell.second << ") בה נמצא " << pieces_at_cell[0]->id << std::endl;
-        }
-    }
-    
     // Check if target cell has pieces and what team they are
-    auto target_pieces_it = pos.find(to);
-    if (target_pieces_it != pos.end() && !target_pieces_it->second.empty()) {
-        auto target_piece = target_pieces_it->second[0];
+    if (!dest_pieces.empty()) {
+        auto target_piece = dest_pieces[0];
         if (target_piece && target_piece->id.length() >= 2 && piece->id.length() >= 2) {
             char moving_team = piece->id[1];
             char target_team = target_piece->id[1];
-            std::cout << "MOVE_VALIDATION: " << piece->id << " (team " << moving_team 
-                      << ") wants to move to cell with " << target_piece->id << " (team " << target_team << ")" << std::endl;
+            KFC_DEBUG(Game, "MOVE_VALIDATION: " << piece->id << " (team " << moving_team 
+                      << ") wants to move to cell with " << target_piece->id << " (team " << target_team << ")");
             
             if (moving_team == target_team) {
-                std::cout << "MOVE_VALIDATION: BLOCKED - Same team!" << std::endl;
+                KFC_DEBUG(Game, "MOVE_VALIDATION: BLOCKED - Same team!");
                 return false; // Block same-team moves
             }
         }
     }
     
-    std::cout << "CALLING piece->state->moves->is_valid() עם " << occupied_cells.size() << " תאים תפוסים" << std::endl;
-    bool result = piece->state->moves->is_valid(from, to, occupied_cells);
-    std::cout << "MOVE_VALIDATION: Result = " << (result ? "VALID" : "INVALID") << std::endl;
+    bool result;
+    if (pos.has_bitboards()) {
+        // 8x8 board: validate against the grid's occupancy bitboard
+        result = piece->state->moves->is_valid(from, to, pos.bitboards().all);
+    } else {
+        std::unordered_set<std::pair<int,int>, PairHash> occupied_cells;
+        pos.for_each_occupied([&](const std::pair<int,int>& cell, const std::vector<PiecePtr>&) {
+            occupied_cells.insert(cell);
+        });
+        result = piece->state->moves->is_valid(from, to, occupied_cells);
+    }
+    KFC_DEBUG(Game, "MOVE_VALIDATION: Result = " << (result ? "VALID" : "INVALID"));
     
     if (!result) {
-        std::cout << "MOVE FAILED ANALYSIS:" << std::endl;
-        std::cout << "  Piece type: " << piece->id[0] << std::endl;
-        std::cout << "  Distance: dx=" << abs(to.first - from.first) << ", dy=" << abs(to.second - from.second) << std::endl;
-        std::cout << "  Path blocking check needed..." << std::endl;
+        KFC_DEBUG(Game, "MOVE FAILED ANALYSIS:");
+        KFC_DEBUG(Game, "  Piece type: " << piece->id[0]);
+        KFC_DEBUG(Game, "  Distance: dx=" << abs(to.first - from.first) << ", dy=" << abs(to.second - from.second));
+        KFC_DEBUG(Game, "  Path blocking check needed...");
     }
     
     return result;
 }
 
+bool Game::is_ready_to_move(const PiecePtr& piece) {
+    if (!piece || !piece->state || !piece->state->moves) {
+        return false;
+    }
+    const auto& name = piece->state->name;
+    return name != "long_rest" && name != "short_rest" && name != "move" && name != "jump";
+}
+
+bool Game::is_jump_valid(const PiecePtr& piece, const std::pair<int,int>& cell) {
+    return is_ready_to_move(piece) && piece->current_cell() == cell;
+}
+
+size_t Game::generate_legal_targets(char color, std::vector<PieceTargets>& out) const {
+    // Large boards have no bitboards: probe each cell with the set-based validator
+    std::unordered_set<std::pair<int,int>, PairHash> occupied_cells;
+    if (!pos.has_bitboards()) {
+        pos.for_each_occupied([&](const std::pair<int,int>& cell, const std::vector<PiecePtr>&) {
+            occupied_cells.insert(cell);
+        });
+    }
+
+    size_t added = 0;
+    for (const auto& piece : pieces) {
+        if (piece->id.size() < 2 || piece->id[1] != color || !is_ready_to_move(piece)) {
+            continue;
+        }
+        PieceTargets entry;
+        entry.piece = piece;
+        entry.from = piece->current_cell();
+        const auto& moves = *piece->state->moves;
+
+        if (pos.has_bitboards() && moves.is_compiled()) {
+            const auto& occ = pos.bitboards();
+            entry.targets = moves.generate(entry.from, occ.all, occ.of_color(color));
+        } else {
+            for (int r = 0; r < board.H_cells; ++r) {
+                for (int c = 0; c < board.W_cells; ++c) {
+                    std::pair<int,int> to{r, c};
+                    const auto& occupants = pos.at(to);
+                    if (to == entry.from) continue;
+                    if (!occupants.empty() && occupants[0]->id.size() >= 2 && occupants[0]->id[1] == color) continue;
+                    if (moves.is_valid(entry.from, to, occupied_cells)) {
+                        entry.cells.push_back(to);
+                    }
+                }
+            }
+        }
+        out.push_back(std::move(entry));
+        ++added;
+    }
+    return added;
+}
+
+char Game::winner() const {
+    if (!is_win()) return 0;
+    for (const auto& piece : pieces) {
+        if (piece->id.size() > 1 && piece->id[0] == 'K') return piece->id[1];
+    }
+    return 0;
+}
+
+char Game::promoting_color() const {
+    return is_promoting_ && promoting_pawn_ && promoting_pawn_->id.size() > 1 ? promoting_pawn_->id[1] : 0;
+}
+
+PlayerScore Game::score(char color) const {
+    return color == 'W' ? scoreManager_->getWhiteScore() : scoreManager_->getBlackScore();
+}
+
+Bot& Game::add_bot(char color, BotConfig config) {
+    if (color != 'W' && color != 'B') {
+        throw std::invalid_argument(std::string("Bot color must be W or B, got ") + color);
+    }
+    // Runs on the bot's thread: stamped and queued like a key press
+    bots_.push_back(std::make_unique<Bot>(color, config, [this](Command cmd) {
+        cmd.timestamp = game_time_ms();
+        enqueue_command(cmd);
+    }));
+    KFC_INFO(Game, "Bot playing " << (color == 'W' ? "white" : "black") << ", " << config.budget_ms << " ms per decision");
+    return *bots_.back();
+}
+
+void Game::feed_bots(int now_ms) {
+    if (bots_.empty() || current_state_ != GameState::PLAYING || is_win()) {
+        return;
+    }
+    for (auto& bot : bots_) {
+        if (bot->wants_position(now_ms)) {
+            bot->submit(make_bot_position(bot->color(), now_ms));
+        }
+    }
+}
+
+// Pieces as the bot sees them: where they will stand, when they take a
+// command again, and the speeds and cooldowns of their state configs
+BotPosition Game::make_bot_position(char color, int now_ms) const {
+    BotPosition position;
+    position.time_ms = now_ms;
+    position.color = color;
+    position.promoting = promoting_color() == color;
+    if (board.W_cells != 8 || board.H_cells != 8) {
+        return position;    // the search is written for the 8x8 board
+    }
+
+    auto next = [](const State* state, const char* event) -> const State* {
+        auto it = state->transitions.find(event);
+        return it != state->transitions.end() ? it->second.lock().get() : nullptr;
+    };
+    auto duration_ms = [](const State* state) {
+        auto timed = state ? std::dynamic_pointer_cast<StaticTemporaryPhysics>(state->physics) : nullptr;
+        return timed ? static_cast<int>(timed->get_duration_s() * 1000.0) : 0;
+    };
+    auto commandable = [](const State* state) {
+        const auto& name = state->name;
+        return state->moves && name != "long_rest" && name != "short_rest" && name != "move" && name != "jump";
+    };
+
+    position.pieces.reserve(pieces.size());
+    for (const auto& piece : pieces) {
+        if (!piece->state || !piece->state->physics || piece->id.size() < 2) {
+            continue;
+        }
+        BotPiece view;
+        view.id = piece->id;
+        view.type = piece->id[0];
+        view.color = piece->id[1];
+        view.cell = piece->state->physics->end_cell;
+
+        // Follow "done" to the state that will take the next command
+        const State* state = piece->state.get();
+        if (!commandable(state)) {
+            int deadline = state->physics->deadline_ms();
+            view.ready_ms = deadline >= 0 ? std::max(0, deadline - now_ms) : 0;
+            state = next(state, "done");
+            for (int hops = 0; state && !commandable(state) && hops < 4; ++hops) {
+                view.ready_ms += duration_ms(state);
+                state = next(state, "done");
+            }
+        }
+        if (state && commandable(state)) {
+            view.moves = state->moves;
+            if (const State* move = next(state, "move")) {
+                auto physics = std::dynamic_pointer_cast<MovePhysics>(move->physics);
+                if (physics && physics->get_speed_m_s() > 0.0) {
+                    view.ms_per_cell = static_cast<int>(1000.0 / physics->get_speed_m_s());
+                }
+                view.move_cooldown_ms = duration_ms(next(move, "done"));
+            }
+            if (const State* jump = next(state, "jump")) {
+                view.jump_ms = duration_ms(jump) + duration_ms(next(jump, "done"));
+            }
+        }
+        position.pieces.push_back(std::move(view));
+    }
+    return position;
+}
+
 char Game::get_piece_color(PiecePtr piece) {
     if (!piece || piece->id.size() < 2) {
         return '?';
@@ -1097,77 +1691,121 @@ void Game::handle_pawn_promotion(PiecePtr pawn) {
     is_promoting_ = true;
     
     // Publish pawn promotion event
-    std::unordered_map<std::string, std::string> eventData;
-    eventData["pawn_id"] = pawn->id;
-    eventPublisher_.publish(GameEvent("pawn_promotion", eventData));
+    events_.post(PawnPromotion{pawn->id});
     
-    std::cout << "\n" << std::string(50, '=') << std::endl;
-    std::cout << "🎉 PAWN PROMOTION! 🎉" << std::endl;
-    std::cout << "Choose your new piece:" << std::endl;
-    std::cout << "  Q - Queen (מלכה)" << std::endl;
-    std::cout << "  R - Rook (צריח)" << std::endl;
-    std::cout << "  B - Bishop (רץ)" << std::endl;
-    std::cout << "  N - Knight (סוס)" << std::endl;
-    std::cout << std::string(50, '=') << std::endl;
+    KFC_INFO(Game, "PAWN PROMOTION (" << pawn->id << ")! Choose your new piece: "
+             << "Q - Queen (מלכה), R - Rook (צריח), B - Bishop (רץ), N - Knight (סוס)");
 }
 
 
 PiecePtr Game::create_promoted_piece(const std::string& piece_type, const std::pair<int,int>& position, char color) {
-    // Create new piece ID: piece_type + color + position
-    std::string new_id = piece_type + color + "_(" + std::to_string(position.first) + "," + std::to_string(position.second) + ")";
-    
-    // Use PieceFactory to create the new piece
-    std::string pieces_root = "pieces/";
-    auto img_factory = std::make_shared<OpenCvImgFactory>();
-    GraphicsFactory gfx_factory(img_factory);
-    PieceFactory piece_factory(board, pieces_root, gfx_factory);
+    if (!piece_factory_) {
+        // No registry from create_game - build one (loads the type from disk once)
+        std::string pieces_root = "pieces/";
+        auto img_factory = std::make_shared<OpenCvImgFactory>();
+        piece_factory_ = std::make_shared<PieceFactory>(board, pieces_root, GraphicsFactory(img_factory));
+    }
     
+    // New piece ID: piece_type + color + position, instantiated from the preloaded prototype
     std::string piece_dir_name = piece_type + color;
-    return piece_factory.create_piece(piece_dir_name, position);
+    return piece_factory_->create_piece(piece_dir_name, position);
 }
 
-void Game::draw_game_start_screen() {
-    auto img_factory = std::make_shared<OpenCvImgFactory>();
-    int background_width = 1920;
-    int background_height = 1080;
-    auto background_img = img_factory->load("pieces/background2.jpg", {background_width, background_height});
-    
-    if (background_img) {
-        // Draw large "KUNG FU CHESS" title at top center - move more to left
-        background_img->put_text("KUNG FU CHESS", 300, 200, 4.0);
-        
-        // Draw "Press any key to start" below - move more to left
-        background_img->put_text("Press any key to start", 400, 300, 2.0);
-        
-        background_img->show();
+Compositor& Game::compositor() {
+    if (!compositor_) {
+        compositor_ = std::make_unique<Compositor>(std::make_shared<OpenCvImgFactory>(),
+                                                   "pieces/background2.jpg");
     }
+    return *compositor_;
 }
 
-void Game::draw_game_over_screen(const std::string& winner) {
-    auto img_factory = std::make_shared<OpenCvImgFactory>();
-    int background_width = 1920;
-    int background_height = 1080;
-    auto background_img = img_factory->load("pieces/background2.jpg", {background_width, background_height});
-    
-    if (background_img) {
-        // Draw medal rectangle as trophy
-        background_img->draw_rect(860, 120, 200, 120, {0, 215, 255}); // Gold rectangle
-        background_img->put_text("TROPHY", 900, 200, 1.5);
-        
-        // Draw winner text
-        std::string win_text;
-        if (winner == "WHITE") {
-            win_text = "WHITE WINS!";
+// Rolling phase timings under the white player's panel (toggle with P):
+// the simulation's from the snapshot, then this thread's own
+void Game::draw_profiler_overlay(ImgPtr background_img, const GameSnapshot& snap) {
+    int y = 700;
+    auto draw = [&](const char* title, const std::vector<std::string>& lines) {
+        background_img->put_text(title, 50, y, 0.6);
+        y += 24;
+        for (const auto& line : lines) {
+            background_img->put_text(line, 50, y, 0.6);
+            y += 24;
+        }
+    };
+    if (snap.profile) {
+        draw("SIMULATION", *snap.profile);
+    }
+    draw("RENDER", render_profiler_.overlay_lines());
+}
+
+// Simulation ticks go to the configured path, rendered frames next to it
+// with a _render suffix
+std::string Game::profile_csv_path() const {
+    const char* env = std::getenv("KFC_PROFILE_CSV");
+    return !profile_csv_path_.empty() ? profile_csv_path_ : (env ? env : "");
+}
+
+// Only an export needs every frame; the overlay uses the rolling window
+void Game::set_profile_csv(const std::string& path) {
+    profile_csv_path_ = path;
+    bool keep = !profile_csv_path().empty();
+    profiler_.keep_history(keep);
+    render_profiler_.keep_history(keep);
+}
+
+void Game::write_profile_csv() const {
+    std::string path = profile_csv_path();
+    if (path.empty()) return;
+
+    auto write = [](const FrameProfiler& profiler, const std::string& file) {
+        if (profiler.frames() == 0) return;
+        if (profiler.write_csv(file)) {
+            KFC_INFO(Game, "Frame profile: " << profiler.frames() << " frames written to " << file);
         } else {
-            win_text = "BLACK WINS!";
+            KFC_WARN(Game, "Frame profile: cannot write " << file);
         }
-        
-        background_img->put_text(win_text, 650, 350, 5.0);
-        
-        // Draw "Press ESC to exit" below
-        background_img->put_text("Press ESC to exit", 750, 450, 2.0);
-        
-        background_img->show();
+    };
+    write(profiler_, path);
+    fs::path render_path(path);
+    render_path.replace_filename(render_path.stem().string() + "_render" + render_path.extension().string());
+    write(render_profiler_, render_path.string());
+}
+
+// Everything draw_score_and_moves and the text overlay depend on
+std::string Game::overlay_signature(const GameSnapshot& snap) {
+    std::ostringstream sig;
+    const auto& ws = snap.white_score;
+    const auto& bs = snap.black_score;
+    sig << ws.captured_pieces << ',' << ws.total_value << ',' << bs.captured_pieces << ',' << bs.total_value;
+    for (const auto* moves : {&snap.white_moves, &snap.black_moves}) {
+        sig << '|';
+        if (*moves && !(*moves)->empty()) {
+            sig << (*moves)->size() << ',' << (*moves)->back();
+        }
+    }
+    sig << '|' << snap.text;
+    // The promotion prompt is drawn over the board: its last frame must
+    // be repainted whole too
+    sig << '|' << snap.promoting;
+    if (show_profiler_) {
+        if (snap.profile) {
+            for (const auto& line : *snap.profile) sig << '|' << line;
+        }
+        for (const auto& line : render_profiler_.overlay_lines()) sig << '|' << line;
+    }
+    return sig.str();
+}
+
+void Game::draw_game_start_screen() {
+    auto screen = compositor().start_screen();
+    if (screen) {
+        screen->show();
+    }
+}
+
+void Game::draw_game_over_screen(const std::string& winner) {
+    auto screen = compositor().game_over_screen(winner);
+    if (screen) {
+        screen->show();
     }
 }
 
@@ -1175,14 +1813,11 @@ void Game::draw_game_over_screen(const std::string& winner) {
 
 // Helper functions for dual cursor system
 void Game::handle_player_select(std::pair<int, int>& cursor_pos, PiecePtr& selected_piece, std::pair<int, int>& selected_pos) {
-    // Update position map before accessing it
-    update_cell2piece_map();
-    
     if (selected_piece == nullptr) {
         // First press - pick up piece under cursor
-        auto cell_pieces_it = pos.find(cursor_pos);
-        if (cell_pieces_it != pos.end() && !cell_pieces_it->second.empty()) {
-            auto piece = cell_pieces_it->second[0];
+        const auto& cell_pieces = pos.at(cursor_pos);
+        if (!cell_pieces.empty()) {
+            auto piece = cell_pieces[0];
             // Check if player can select this piece
             if (can_select_piece(piece, current_player_)) {
                 selected_piece = piece;
@@ -1204,17 +1839,10 @@ void Game::handle_player_select(std::pair<int, int>& cursor_pos, PiecePtr& selec
                 if (piece_it != piece_by_id.end()) {
                     auto piece = piece_it->second;
                     if (piece && piece->state) {
-                        // Update position map again before passing to piece
-                        update_cell2piece_map();
-                        piece->on_command(move_cmd, pos);
+                        dispatch_to_piece(piece, move_cmd);
                         
                         // Publish move event
-                        std::unordered_map<std::string, std::string> eventData;
-                        eventData["piece_id"] = selected_piece->id;
-                        eventData["from"] = std::to_string(selected_pos.first) + "," + std::to_string(selected_pos.second);
-                        eventData["to"] = std::to_string(cursor_pos.first) + "," + std::to_string(cursor_pos.second);
-                        eventData["timestamp"] = std::to_string(game_time_ms());
-                        eventPublisher_.publish(GameEvent("piece_moved", eventData));
+                        events_.post(PieceMoved{selected_piece->id, selected_pos, cursor_pos, game_time_ms()});
                         
 
                     }
@@ -1238,9 +1866,8 @@ void Game::handle_player_jump(PiecePtr& selected_piece, std::pair<int, int>& sel
         auto piece_it = piece_by_id.find(jump_cmd.piece_id);
         if (piece_it != piece_by_id.end()) {
             auto piece = piece_it->second;
-            if (piece && piece->state) {
-                update_cell2piece_map();
-                piece->on_command(jump_cmd, pos);
+            if (is_jump_valid(piece, selected_pos)) {
+                dispatch_to_piece(piece, jump_cmd);
             }
         }
         
@@ -1250,16 +1877,16 @@ void Game::handle_player_jump(PiecePtr& selected_piece, std::pair<int, int>& sel
     }
 }
 
-Game create_game(const std::string& pieces_root, ImgFactoryPtr img_factory) {
+Game create_game(const std::string& pieces_root, ImgFactoryPtr img_factory, bool with_audio) {
     // Load board image
     std::string board_img_path = pieces_root + "board.png";
-    std::cout << "🖼️ Trying to load board image: " << board_img_path << std::endl;
+    KFC_INFO(Game, "🖼️ Trying to load board image: " << board_img_path);
     auto board_img = img_factory->load(board_img_path, {640, 640});
     if (!board_img) {
-        std::cout << "❌ Failed to load board image: " << board_img_path << std::endl;
+        KFC_ERROR(Game, "❌ Failed to load board image: " << board_img_path);
         throw std::runtime_error("Failed to load board image: " + board_img_path);
     }
-    std::cout << "✅ Board image loaded successfully" << std::endl;
+    KFC_INFO(Game, "✅ Board image loaded successfully");
     
     // Create board (8x8 chess board)
     Board board(80, 80, 8, 8, board_img);
@@ -1267,19 +1894,35 @@ Game create_game(const std::string& pieces_root, ImgFactoryPtr img_factory) {
     // Create graphics factory
     GraphicsFactory gfx_factory(img_factory);
     
-    // Create piece factory
-    PieceFactory piece_factory(board, pieces_root, gfx_factory);
+    // Create piece factory - kept by the game as its prototype registry
+    auto piece_factory = std::make_shared<PieceFactory>(board, pieces_root, gfx_factory);
     
-    // Load pieces from board.csv
-    std::string board_csv_path = pieces_root + "board.csv";
-    auto pieces = piece_factory.create_pieces_from_board_csv(board_csv_path);
-    
-    return Game(pieces, board);
+    // Promotion targets are ready before the first move
+    std::vector<std::string> promotable;
+    for (const char* type : {"Q", "R", "B", "N"}) {
+        for (const char* color : {"W", "B"}) {
+            if (fs::is_directory(fs::path(pieces_root) / (std::string(type) + color))) {
+                promotable.push_back(std::string(type) + color);
+            }
+        }
+    }
+    piece_factory->preload(promotable);
+
+    return create_game(piece_factory, board, pieces_root + "board.csv", with_audio);
+}
+
+Game create_game(const std::shared_ptr<PieceFactory>& piece_factory, const Board& board,
+                 const std::string& board_csv_path, bool with_audio) {
+    auto pieces = piece_factory->create_pieces_from_board_csv(board_csv_path);
+    KFC_DEBUG(Game, "Piece types: " << piece_factory->cached_types() << " prototypes for "
+              << pieces.size() << " pieces, sprite cache: " << SpriteCache::instance().size()
+              << " images decoded");
+    return Game(pieces, board, piece_factory, with_audio);
 }
 
 // Removed direct score and move tracking - now using Publisher-Subscriber pattern
 
-void Game::draw_score_and_moves(ImgPtr background_img) {
+void Game::draw_score_and_moves(ImgPtr background_img, const GameSnapshot& snap) {
     if (!background_img) return;
     
     // Board position
@@ -1291,9 +1934,8 @@ void Game::draw_score_and_moves(ImgPtr background_img) {
     int white_x = 50;
     int white_y = board_y;
     
-    // Get data from managers via Publisher-Subscriber pattern
-    const auto& white_score = scoreManager_->getWhiteScore();
-    const auto& white_moves = moveHistoryManager_->getWhiteMoves();
+    // Scores and move lists as of the snapshot's tick
+    const auto& white_score = snap.white_score;
     
     // White score
     background_img->put_text("WHITE SCORE", white_x, white_y, 1.5);
@@ -1303,21 +1945,19 @@ void Game::draw_score_and_moves(ImgPtr background_img) {
     // White moves
     background_img->put_text("WHITE MOVES", white_x, white_y + 120, 1.5);
     int move_y = white_y + 160;
-    for (const auto& move : white_moves) {
-        int time_sec = move.timestamp / 1000;
-        std::string move_text = std::to_string(time_sec) + "s " + move.piece_id.substr(0,2) + ": " + move.from_pos + "-" + move.to_pos;
-        background_img->put_text(move_text, white_x, move_y, 0.8);
-        move_y += 25;
-        if (move_y > white_y + 400) break; // Limit display area
+    if (snap.white_moves) {
+        for (const auto& move_text : *snap.white_moves) {
+            background_img->put_text(move_text, white_x, move_y, 0.8);
+            move_y += 25;
+            if (move_y > white_y + 400) break; // Limit display area
+        }
     }
     
     // Black player info (right side)
     int black_x = board_x + board_size + 50;
     int black_y = board_y;
     
-    // Get data from managers
-    const auto& black_score = scoreManager_->getBlackScore();
-    const auto& black_moves = moveHistoryManager_->getBlackMoves();
+    const auto& black_score = snap.black_score;
     
     // Black score
     background_img->put_text("BLACK SCORE", black_x, black_y, 1.5);
@@ -1327,11 +1967,11 @@ void Game::draw_score_and_moves(ImgPtr background_img) {
     // Black moves
     background_img->put_text("BLACK MOVES", black_x, black_y + 120, 1.5);
     move_y = black_y + 160;
-    for (const auto& move : black_moves) {
-        int time_sec = move.timestamp / 1000;
-        std::string move_text = std::to_string(time_sec) + "s " + move.piece_id.substr(0,2) + ": " + move.from_pos + "-" + move.to_pos;
-        background_img->put_text(move_text, black_x, move_y, 0.8);
-        move_y += 25;
-        if (move_y > black_y + 400) break; // Limit display area
+    if (snap.black_moves) {
+        for (const auto& move_text : *snap.black_moves) {
+            background_img->put_text(move_text, black_x, move_y, 0.8);
+            move_y += 25;
+            if (move_y > black_y + 400) break; // Limit display area
+        }
     }
-}
\ No newline at end of file
+}
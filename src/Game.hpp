@@ -1,8 +1,20 @@
 #pragma once
 
 #include "Board.hpp"
+#include "OccupancyGrid.hpp"
+#include "PieceScheduler.hpp"
+#include "CapturePredictor.hpp"
+#include "PositionHash.hpp"
+#include "Compositor.hpp"
+#include "BoardSurface.hpp"
+#include "FrameProfiler.hpp"
+#include "GameSnapshot.hpp"
+#include "TripleBuffer.hpp"
 #include "PieceFactory.hpp"
 #include "Command.hpp"
+#include "MpscRing.hpp"
+#include "Bot.hpp"
+#include "CommandLog.hpp"
 #include <memory>
 #include <vector>
 #include <stdexcept>
@@ -14,6 +26,7 @@
 #include <sstream>
 #include "GraphicsFactory.hpp"
 #include "Common.hpp"
+#include "Clock.hpp"
 #include "img/OpenCvImg.hpp"
 #include <chrono>
 #include <thread>
@@ -24,10 +37,12 @@
 #include <opencv2/opencv.hpp>
 // Threading support from CTD25_1
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
+#include <cmath>
+#include <cstdlib>
 // Event system
 #include "EventSystem.hpp"
+#include "GameEvents.hpp"
 #include "AudioManager.hpp"
 #include "TextManager.hpp"
 #include "ScoreManager.hpp"
@@ -48,20 +63,27 @@ public:
     explicit InvalidBoard(const std::string& msg) : std::runtime_error(msg) {}
 };
 
-enum class GameState {
-    STARTING,    // מציג מסך התחלה
-    PLAYING,     // משחק רגיל
-    GAME_OVER    // מציג מסך סיום
-};
-
 enum class CurrentPlayer {
     WHITE,
     BLACK
 };
 
+// Legal destinations of one piece, as produced by Game::generate_legal_targets
+struct PieceTargets {
+    PiecePtr piece;
+    std::pair<int,int> from;
+    Bitboard targets = 0;                        // 8x8 boards
+    std::vector<std::pair<int,int>> cells;       // boards without bitboards
+};
+
 class Game {
 public:
-    Game(std::vector<PiecePtr> pcs, Board board);
+    // piece_factory: prototype registry used to spawn pieces mid-game
+    // (promotion); created on first use when not given.
+    // with_audio = false skips loading and playing sounds (self-play, servers)
+    Game(std::vector<PiecePtr> pcs, Board board, std::shared_ptr<PieceFactory> piece_factory = nullptr,
+         bool with_audio = true);
+    ~Game();
 
     // --- main public API ---
     int game_time_ms() const;
@@ -70,34 +92,154 @@ public:
     // Mirror Python run() behaviour with enhanced threading support
     void run(int num_iterations = -1, bool is_with_graphics = true);
 
+    // Wait for a line on stdin. A reader left by a destroyed Game is still
+    // blocked on stdin and takes that line itself, so this waits for it
+    // to finish instead of competing for it
+    static void wait_for_enter();
+
     std::vector<PiecePtr> pieces;
     Board board;
     
-    // helper for tests to inject commands
+    // Queue a command from any thread; it is applied by the first tick at or
+    // after its timestamp
     void enqueue_command(const Command& cmd);
 
+    // Headless fixed-timestep simulation: every tick advances a virtual clock
+    // by step_ms and runs the update/capture pipeline. No real time, no OpenCV.
+    // num_ticks < 0 runs until a king is captured.
+    void run_simulation(int num_ticks, int step_ms = 16);
+
+    // Computer player for 'W' or 'B'; it searches on its own thread and
+    // sends its moves through enqueue_command. run() adds one per color
+    // listed in KFC_BOT (e.g. "B" or "WB") when none was added.
+    Bot& add_bot(char color, BotConfig config = {});
+
+    // 'W' or 'B' once the other king has been captured, otherwise 0
+    char winner() const;
+    // Captures made by one color so far
+    PlayerScore score(char color) const;
+    // Color of the pawn waiting for its promotion choice, otherwise 0
+    char promoting_color() const;
+
+    // Jumps are in place: 'cell' must be where a piece ready to move stands
+    static bool is_jump_valid(const PiecePtr& piece, const std::pair<int,int>& cell);
+
+    // Legal destinations of every idle piece of one color ('W'/'B') in one
+    // pass over the current occupancy. Appends to 'out', returns pieces added.
+    size_t generate_legal_targets(char color, std::vector<PieceTargets>& out) const;
+
+    // Replace the game time source (steady clock by default)
+    void set_clock(ClockPtr clock);
+    void set_simulation_step_ms(int step_ms) { sim_step_ms_ = step_ms; }
+
+    // Per-phase frame timings; written as CSV when run() ends if a path is set
+    // here or in KFC_PROFILE_CSV
+    const FrameProfiler& profiler() const { return profiler_; }
+    void set_profile_csv(const std::string& path);
+
+    // Every move of the game (compact; see MoveLog). Owned by the simulation:
+    // read it once run() / run_simulation() has returned.
+    const MoveLog& move_log() const { return moveHistoryManager_->log(); }
+
+    // Record every tick time and applied command (see CommandLog). run()
+    // starts a recording itself when a path is set here or in KFC_RECORD,
+    // and finishes and saves it when the game ends.
+    void set_recording(std::shared_ptr<CommandLog> log) { recording_ = std::move(log); }
+    std::shared_ptr<CommandLog> recording() const { return recording_; }
+    void set_record_path(const std::string& path) { record_path_ = path; }
+    // Close the recording with the current time and board checksum, and save
+    // it if a path is set. Called by run(); headless callers call it themselves.
+    void finish_recording();
+
+    // Headless: one tick at exactly now_ms on a virtual clock (replay)
+    void step_to(int now_ms);
+    // Nothing moving, resting, queued or thinking: a tick would change
+    // nothing, so hosts may skip it (simulation thread, between ticks)
+    bool is_quiet() const;
+
+    // Zobrist hash of the position at the current game time (see
+    // PositionHash): pieces, cells, states and remaining cooldowns
+    uint64_t board_checksum() const;
+    const PositionHash& position_hash() const { return position_hash_; }
+
 private:
     // --- helpers mirroring Python implementation ---
-    void start_user_input_thread();
+    // What the stdin reader shares with the game. A blocked getline cannot
+    // be interrupted, so the reader may outlive the Game: it owns only this
+    struct StdinFeed {
+        std::atomic<bool> open{true};
+        ClockPtr clock;                     // atomic_load/atomic_store
+        std::mutex mutex;
+        std::vector<Command> commands;      // parsed, not yet drained
+        std::atomic<bool> has_commands{false};
+    };
+
+    void start_user_input_thread(bool read_stdin);
+    static void input_loop(std::shared_ptr<StdinFeed> feed);
+    static bool parse_input_line(const std::string& line, int timestamp, Command& cmd);
     void run_game_loop(int num_iterations, bool is_with_graphics);
     void update_cell2piece_map();
+    void tick(int now_ms);
+    void drain_command_queue(int now_ms);
+    void apply_command(const Command& cmd);
+    void dispatch_to_piece(const PiecePtr& piece, const Command& cmd);
     void process_input(const Command& cmd);
-    void resolve_collisions();
-    void announce_win() const;
+    void resolve_collisions(int now_ms);
+    void announce_win();
 
     void validate();
     bool is_win() const;
 
     std::unordered_map<std::string, PiecePtr> piece_by_id;
-    // Map from board cell to list of occupying pieces
-    std::unordered_map<std::pair<int,int>, std::vector<PiecePtr>, PairHash> pos;
+    // Board cell -> occupying pieces, updated incrementally
+    OccupancyGrid pos;
+    // Deadline-driven piece updates (only active pieces each tick)
+    PieceScheduler scheduler_;
+    // Capture contacts scheduled at their exact ms
+    CapturePredictor capture_predictor_;
+    // Capture bookkeeping for CaptureRules, per game
+    std::set<std::string> already_captured_;
+    std::set<std::pair<std::string, std::string>> reported_collisions_;
+    // Kept by the pieces' own transitions, captures and promotions
+    PositionHash position_hash_;
     
+    // Commands from any thread (window keys, stdin, tests), stamped when
+    // captured and drained at the start of every tick. A tick sees a few
+    // keys at most; bursts past the ring go to the overflow list, so the
+    // ring stays small (hosts keep hundreds of games).
+    MpscRing<Command, 128> command_queue_;
+    std::mutex overflow_mutex_;                 // only used when the ring is full
+    std::vector<Command> command_overflow_;
+    std::atomic<bool> has_overflow_{false};
+    std::vector<Command> waiting_commands_;     // simulation thread: not due yet
+    std::shared_ptr<StdinFeed> stdin_feed_;
+    std::thread input_thread_;
+
     // Enhanced threading support from CTD25_1
-    std::queue<Command> user_input_queue;
-    std::queue<std::string> string_input_queue;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
     std::atomic<bool> running_{false};
+
+    // Windowed mode: the simulation thread publishes a snapshot every tick,
+    // the main thread renders the newest one
+    static constexpr int kRenderWaitMs = 15;
+    std::thread sim_thread_;
+    TripleBuffer<GameSnapshot> snapshots_;
+    uint64_t snapshot_seq_ = 0;
+    GameSnapshot::Lines white_move_lines_;
+    GameSnapshot::Lines black_move_lines_;
+    size_t white_move_lines_count_ = 0;
+    size_t black_move_lines_count_ = 0;
+    GameSnapshot::Lines profile_lines_;
+    GameSnapshot view_;         // render thread: newest snapshot
+    GameSnapshot view_prev_;    // and the one before, for interpolation
+    void simulation_loop();
+    void update_game_flow();
+    void publish_snapshot(int now_ms);
+    static GameSnapshot::Lines move_lines(const MoveHistoryManager::RecentMoves& moves, size_t total,
+                                          GameSnapshot::Lines& cache, size_t& cached_total);
+    void render_loop();
+    void render_frame(const GameSnapshot& snap);
+    bool handle_render_key(int key, int captured_ms, const GameSnapshot& snap);
+    std::pair<int,int> interpolated_pos(const GameSnapshot::PieceView& piece, size_t index, double alpha) const;
     std::mutex positions_mutex_;
     std::mutex input_mutex_;
     
@@ -124,8 +266,12 @@ private:
     PiecePtr promoting_pawn_ = nullptr;
     bool is_promoting_ = false;
 
-    // Event system
+    // Event system: string-keyed publishers for ISubscriber implementations,
+    // fed by the typed bus game code posts to (declared first so they outlive
+    // the bus's worker thread)
     EventPublisher eventPublisher_;
+    EventPublisher audioPublisher_;     // delivered on the bus's worker thread
+    GameEventBus events_;
     std::shared_ptr<AudioManager> audioManager_;
     std::shared_ptr<TextManager> textManager_;
     
@@ -133,9 +279,11 @@ private:
     std::shared_ptr<ScoreManager> scoreManager_;
     std::shared_ptr<MoveHistoryManager> moveHistoryManager_;
     
-    void draw_score_and_moves(ImgPtr background_img);
+    void draw_score_and_moves(ImgPtr background_img, const GameSnapshot& snap);
 
-    std::chrono::steady_clock::time_point start_tp;
+    ClockPtr clock_;
+    int sim_step_ms_ = 16;
+    std::vector<Command> pending_commands_;
     
     // Helper functions for user interaction
     void handle_mouse_click(int x, int y);
@@ -152,10 +300,11 @@ private:
     void handle_player_jump(PiecePtr& selected_piece, std::pair<int, int>& selected_pos);
     std::string cell_to_chess_notation(int x, int y);
     PiecePtr find_piece_by_id(const std::string& id);
-    void check_captures();
+    void check_captures(int now_ms);
     void capture_piece(PiecePtr captured, PiecePtr captor);
     std::string get_position_key(int x, int y);
     bool is_move_valid(PiecePtr piece, const std::pair<int,int>& from, const std::pair<int,int>& to);
+    static bool is_ready_to_move(const PiecePtr& piece);
     char get_piece_color(PiecePtr piece);
     bool are_same_color(PiecePtr piece1, PiecePtr piece2);
     
@@ -163,6 +312,7 @@ private:
     bool needs_promotion(PiecePtr piece);
     void handle_pawn_promotion(PiecePtr pawn);
     PiecePtr create_promoted_piece(const std::string& piece_type, const std::pair<int,int>& position, char color);
+    std::shared_ptr<PieceFactory> piece_factory_;
     
     // Game state and screen display functions
     GameState current_state_ = GameState::STARTING;
@@ -176,8 +326,38 @@ private:
     
     void draw_game_start_screen();
     void draw_game_over_screen(const std::string& winner);
+    // Pre-decoded static layers, created on first draw
+    std::unique_ptr<Compositor> compositor_;
+    Compositor& compositor();
+    // Board repainted by dirty rectangles, and the last presented frame
+    BoardSurface board_surface_;
+    std::vector<BoardSurface::Sprite> frame_sprites_;
+    std::vector<BoardSurface::Marker> frame_markers_;
+    ImgPtr frame_img_;
+    std::string last_overlay_;
+    std::string overlay_signature(const GameSnapshot& snap);
+    FrameProfiler profiler_;            // simulation ticks
+    FrameProfiler render_profiler_;     // rendered frames
+    std::atomic<bool> show_profiler_{std::getenv("KFC_PROFILE_OVERLAY") != nullptr};
+    std::string profile_csv_path_;
+    void draw_profiler_overlay(ImgPtr background_img, const GameSnapshot& snap);
+    std::string profile_csv_path() const;     // empty: no export, no history
+    void write_profile_csv() const;
     void update_display_text();
+
+    std::shared_ptr<CommandLog> recording_;
+    std::string record_path_;
+    std::shared_ptr<VirtualClock> use_virtual_clock();
+
+    // Last members: their workers stop before the command queue goes away
+    std::vector<std::unique_ptr<Bot>> bots_;
+    void feed_bots(int now_ms);
+    BotPosition make_bot_position(char color, int now_ms) const;
 };
 
 // Factory function to create game from pieces directory
-Game create_game(const std::string& pieces_root, ImgFactoryPtr img_factory);
\ No newline at end of file
+Game create_game(const std::string& pieces_root, ImgFactoryPtr img_factory, bool with_audio = true);
+// Game on an already loaded board and prototype registry, which many games
+// may share (the registry must hold every type they can spawn)
+Game create_game(const std::shared_ptr<PieceFactory>& piece_factory, const Board& board,
+                 const std::string& board_csv_path, bool with_audio = true);
\ No newline at end of file
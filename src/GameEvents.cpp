@@ -0,0 +1,75 @@
+#include "GameEvents.hpp"
+
+namespace {
+std::string cell_text(const std::pair<int,int>& cell) {
+    return std::to_string(cell.first) + "," + std::to_string(cell.second);
+}
+
+template <typename Event>
+void forward(GameEventBus& bus, EventPublisher& legacy, const char* type, Delivery delivery, bool coalesce) {
+    if (!legacy.has_subscribers(type)) {
+        return;
+    }
+    bus.subscribe<Event>([&legacy](const Event& event) {
+        legacy.publish(to_game_event(event));
+    }, delivery, coalesce);
+}
+}
+
+GameEvent to_game_event(const GameStarted&) {
+    return GameEvent("game_started");
+}
+
+GameEvent to_game_event(const GamePlaying&) {
+    return GameEvent("game_playing");
+}
+
+GameEvent to_game_event(const GameEnded& event) {
+    GameEvent out("game_ended");
+    if (event.draw) {
+        out.data["result"] = "DRAW";
+    } else if (event.winner) {
+        out.data["winner"] = event.winner == 'W' ? "WHITE" : "BLACK";
+        out.data["winner_color"] = std::string(1, event.winner);
+    }
+    return out;
+}
+
+GameEvent to_game_event(const PieceMoved& event) {
+    GameEvent out("piece_moved");
+    out.data["piece_id"] = event.piece_id;
+    out.data["from"] = cell_text(event.from);
+    out.data["to"] = cell_text(event.to);
+    out.data["timestamp"] = std::to_string(event.timestamp);
+    return out;
+}
+
+GameEvent to_game_event(const PieceCaptured& event) {
+    GameEvent out("piece_captured");
+    out.data["captured"] = event.captured;
+    out.data["captor"] = event.captor;
+    return out;
+}
+
+GameEvent to_game_event(const PawnPromotion& event) {
+    GameEvent out("pawn_promotion");
+    out.data["pawn_id"] = event.pawn_id;
+    return out;
+}
+
+GameEvent to_game_event(const PawnPromoted& event) {
+    GameEvent out("pawn_promoted");
+    out.data["pawn_id"] = event.pawn_id;
+    out.data["piece_id"] = event.piece_id;
+    return out;
+}
+
+void bridge_to_legacy(GameEventBus& bus, EventPublisher& legacy, Delivery delivery, bool coalesce) {
+    forward<GameStarted>(bus, legacy, "game_started", delivery, coalesce);
+    forward<GamePlaying>(bus, legacy, "game_playing", delivery, coalesce);
+    forward<GameEnded>(bus, legacy, "game_ended", delivery, coalesce);
+    forward<PieceMoved>(bus, legacy, "piece_moved", delivery, coalesce);
+    forward<PieceCaptured>(bus, legacy, "piece_captured", delivery, coalesce);
+    forward<PawnPromotion>(bus, legacy, "pawn_promotion", delivery, coalesce);
+    forward<PawnPromoted>(bus, legacy, "pawn_promoted", delivery, coalesce);
+}
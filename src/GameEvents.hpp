@@ -0,0 +1,59 @@
+#pragma once
+
+#include "EventBus.hpp"
+#include "EventSystem.hpp"
+#include <string>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// Typed game events. Piece ids are a few characters, so copying an event
+// stays within the string's inline buffer.
+// ---------------------------------------------------------------------------
+struct GameStarted {};
+
+struct GamePlaying {};
+
+struct GameEnded {
+    char winner = 0;        // 'W' / 'B' once the winner is announced, 0 otherwise
+    bool draw = false;      // both kings captured
+};
+
+struct PieceMoved {
+    std::string piece_id;
+    std::pair<int,int> from;
+    std::pair<int,int> to;
+    int timestamp = 0;      // ms, when the move was commanded
+};
+
+struct PieceCaptured {
+    std::string captured;
+    std::string captor;
+};
+
+struct PawnPromotion {
+    std::string pawn_id;    // waiting for Q/R/B/N
+};
+
+struct PawnPromoted {
+    std::string pawn_id;
+    std::string piece_id;   // the piece that replaced it
+};
+
+using GameEventBus = EventBus<GameStarted, GamePlaying, GameEnded, PieceMoved,
+                              PieceCaptured, PawnPromotion, PawnPromoted>;
+
+// String-keyed form of each event ("piece_moved" with "piece_id", "from",
+// "to", "timestamp", ...) for ISubscriber implementations
+GameEvent to_game_event(const GameStarted& event);
+GameEvent to_game_event(const GamePlaying& event);
+GameEvent to_game_event(const GameEnded& event);
+GameEvent to_game_event(const PieceMoved& event);
+GameEvent to_game_event(const PieceCaptured& event);
+GameEvent to_game_event(const PawnPromotion& event);
+GameEvent to_game_event(const PawnPromoted& event);
+
+// Forward typed events to a string-keyed publisher, delivered and coalesced
+// as given. Only types the publisher already has subscribers for are bridged,
+// so subscribe to it first.
+void bridge_to_legacy(GameEventBus& bus, EventPublisher& legacy,
+                      Delivery delivery = Delivery::Inline, bool coalesce = false);
@@ -0,0 +1,500 @@
+#include "GameServer.hpp"
+#include "Game.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+
+struct GameServer::Session {
+    Socket socket;
+    net::FrameBuffer in;                    // network thread
+    MatchHost::MatchId match{0};            // network thread; 0 until joined
+    char color{0};                          // 'W', 'B', or 'S' watching
+    size_t known_ids{0};                    // match's tick: id table entries sent
+    bool needs_keyframe{true};              // match's tick: no board yet
+    bool told_game_over{false};             // match's tick: GameOver sent
+
+    std::mutex out_mutex;
+    std::string outbox;                     // guarded by out_mutex: not taken by the socket yet
+    bool dead{false};                       // guarded by out_mutex
+    std::atomic<bool> has_outbox{false};
+};
+
+struct GameServer::ServerMatch {
+    struct Pending {
+        Command cmd;
+        uint32_t seq;
+        SessionPtr from;
+    };
+
+    MatchHost::MatchId id{0};
+    std::mutex mutex;
+    SessionPtr seats[2];                    // white, black; guarded by mutex
+    std::vector<SessionPtr> watchers;       // guarded by mutex
+    std::vector<Pending> inbox;             // guarded by mutex: for the next tick
+    bool over{false};                       // guarded by mutex
+
+    // Tick worker only (one at a time per match)
+    std::vector<Pending> applying;          // this tick's batch
+    std::vector<std::string> ids;
+    std::unordered_map<std::string, uint32_t> id_index;
+    uint64_t ticks{0};
+    net::SnapshotEncoder snapshot;
+    std::vector<net::VisiblePiece> board;
+    net::TickFrame frame;
+    std::string out;
+};
+
+namespace {
+int seat_of(char color) { return color == 'W' ? 0 : 1; }
+}
+
+GameServer::GameServer(GameServerConfig config)
+    : config_(std::move(config)), host_(config_.matches) {
+    host_.set_before_tick([this](MatchHost::MatchId id, Game& game, int now) { before_tick(id, game, now); });
+    host_.set_tick_observer([this](MatchHost::MatchId id, Game& game, int now) { after_tick(id, game, now); });
+}
+
+GameServer::~GameServer() {
+    stop();
+}
+
+void GameServer::start() {
+    if (running_) return;
+    listener_ = Socket::listen_tcp(config_.host, config_.port);
+    listener_.set_nonblocking(true);
+    port_ = listener_.local_port();
+    host_.start();
+    running_ = true;
+    network_thread_ = std::thread([this] { network_loop(); });
+    KFC_INFO(Net, "Serving on " << config_.host << ":" << port_);
+}
+
+void GameServer::stop() {
+    if (!running_.exchange(false)) return;
+    // Workers first: their hooks reach into sessions and matches
+    host_.stop();
+    if (network_thread_.joinable()) {
+        network_thread_.join();
+    }
+    sessions_.clear();
+    open_seats_.clear();
+    {
+        std::lock_guard<std::mutex> lock(matches_mutex_);
+        matches_.clear();
+    }
+    session_count_ = 0;
+    listener_.close();
+}
+
+GameServer::Stats GameServer::stats() const {
+    Stats s;
+    s.sessions = session_count_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(matches_mutex_);
+        s.matches = matches_.size();
+    }
+    s.commands = commands_.load(std::memory_order_relaxed);
+    s.rejected = rejected_.load(std::memory_order_relaxed);
+    s.ticks_sent = ticks_sent_.load(std::memory_order_relaxed);
+    s.tick_bytes = tick_bytes_.load(std::memory_order_relaxed);
+    s.keyframes = keyframes_.load(std::memory_order_relaxed);
+    s.bytes_in = bytes_in_.load(std::memory_order_relaxed);
+    s.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+    return s;
+}
+
+GameServer::ServerMatchPtr GameServer::find_match(MatchHost::MatchId id) const {
+    std::lock_guard<std::mutex> lock(matches_mutex_);
+    auto it = matches_.find(id);
+    return it != matches_.end() ? it->second : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+void GameServer::network_loop() {
+    std::vector<Socket::PollItem> items;
+    while (running_) {
+        items.clear();
+        items.push_back({listener_.handle()});
+        for (const auto& session : sessions_) {
+            items.push_back({session->socket.handle(), session->has_outbox.load(std::memory_order_acquire)});
+        }
+        // Short timeout: outboxes filled by workers meanwhile are picked up
+        // on the next round
+        try {
+            if (Socket::poll(items, 5) == 0) continue;
+        } catch (const std::exception& e) {
+            KFC_ERROR(Net, e.what());
+            continue;
+        }
+
+        std::vector<SessionPtr> gone;
+        for (size_t i = 1; i < items.size(); ++i) {
+            const SessionPtr& session = sessions_[i - 1];
+            if (items[i].writable) flush(*session);
+            if (items[i].readable && !read(session)) {
+                gone.push_back(session);
+                continue;
+            }
+            // Frames read may have to wait for the socket
+            std::lock_guard<std::mutex> lock(session->out_mutex);
+            if (session->dead) gone.push_back(session);
+        }
+        for (const auto& session : gone) {
+            leave(session);
+        }
+        if (items[0].readable) {
+            accept_all();
+        }
+    }
+}
+
+void GameServer::accept_all() {
+    for (;;) {
+        Socket socket = listener_.accept();
+        if (!socket.valid()) return;
+        socket.set_nonblocking(true);
+        socket.set_nodelay(true);
+        auto session = std::make_shared<Session>();
+        session->socket = std::move(socket);
+        sessions_.push_back(std::move(session));
+        session_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// false when the session is done (closed, error, bad frame)
+bool GameServer::read(const SessionPtr& session) {
+    char buffer[4096];
+    for (;;) {
+        long got = session->socket.recv_some(buffer, sizeof(buffer));
+        if (got == -1) break;           // drained
+        if (got <= 0) return false;
+        bytes_in_.fetch_add(static_cast<uint64_t>(got), std::memory_order_relaxed);
+        session->in.append(buffer, static_cast<size_t>(got));
+    }
+    try {
+        net::FrameBuffer::Frame frame;
+        while (session->in.next(frame)) {
+            handle(session, frame);
+        }
+    } catch (const std::exception& e) {
+        KFC_WARN(Net, "Dropping client: " << e.what());
+        return false;
+    }
+    return true;
+}
+
+void GameServer::flush(Session& session) {
+    std::lock_guard<std::mutex> lock(session.out_mutex);
+    if (session.dead || session.outbox.empty()) return;
+    long sent = session.socket.send_some(session.outbox.data(), session.outbox.size());
+    if (sent < 0) {
+        session.dead = true;
+        return;
+    }
+    bytes_out_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    session.outbox.erase(0, static_cast<size_t>(sent));
+    session.has_outbox.store(!session.outbox.empty(), std::memory_order_release);
+}
+
+bool GameServer::send(Session& session, const std::string& bytes) {
+    std::lock_guard<std::mutex> lock(session.out_mutex);
+    if (session.dead) return false;
+    size_t offset = 0;
+    // Nothing queued ahead: straight to the socket
+    if (session.outbox.empty()) {
+        long sent = session.socket.send_some(bytes.data(), bytes.size());
+        if (sent < 0) {
+            session.dead = true;
+            return false;
+        }
+        offset = static_cast<size_t>(sent);
+        bytes_out_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    }
+    if (offset == bytes.size()) return true;
+    if (session.outbox.size() + bytes.size() - offset > kMaxOutbox) {
+        session.dead = true;            // not reading: drop it
+        return false;
+    }
+    session.outbox.append(bytes, offset, std::string::npos);
+    session.has_outbox.store(true, std::memory_order_release);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+void GameServer::handle(const SessionPtr& session, const net::FrameBuffer::Frame& frame) {
+    net::Reader in(frame.body, frame.size);
+    switch (frame.type) {
+    case net::Msg::Join: {
+        char color = static_cast<char>(in.u8());
+        if (session->match != 0) throw std::runtime_error("joined twice");
+        if (color != 0 && color != 'W' && color != 'B') throw std::runtime_error("bad color");
+        join(session, color);
+        break;
+    }
+    case net::Msg::Watch: {
+        auto id = static_cast<MatchHost::MatchId>(in.varint());
+        if (session->match != 0) throw std::runtime_error("joined twice");
+        watch(session, id);
+        break;
+    }
+    case net::Msg::Command: {
+        uint32_t seq = 0;
+        Command cmd = net::read_command(in, seq);
+        receive_command(*session, seq, std::move(cmd));
+        break;
+    }
+    default:
+        throw std::runtime_error("unexpected message " + std::to_string(static_cast<int>(frame.type)));
+    }
+}
+
+// The oldest match with the wanted seat free, otherwise a new one
+void GameServer::join(const SessionPtr& session, char color) {
+    // Seated and welcomed under the match lock: Welcome is the first frame
+    // a seat gets, ahead of any tick
+    auto take_seat = [&](ServerMatch& match, int seat) {
+        match.seats[seat] = session;
+        session->match = match.id;
+        session->color = seat == 0 ? 'W' : 'B';
+        std::string out;
+        net::write_welcome(out, match.id, session->color, seat + 1);
+        send(*session, out);
+        return match.seats[0] && match.seats[1];
+    };
+
+    ServerMatchPtr match;
+    bool full = false;
+    for (auto it = open_seats_.begin(); it != open_seats_.end() && !match; ++it) {
+        std::lock_guard<std::mutex> lock((*it)->mutex);
+        if ((*it)->over) continue;
+        for (int seat = 0; seat < 2; ++seat) {
+            if ((color == 0 || seat_of(color) == seat) && !(*it)->seats[seat]) {
+                match = *it;
+                full = take_seat(*match, seat);
+                break;
+            }
+        }
+    }
+    if (!match) {
+        match = std::make_shared<ServerMatch>();
+        match->id = host_.open_match();
+        {
+            std::lock_guard<std::mutex> lock(match->mutex);
+            take_seat(*match, color == 0 ? 0 : seat_of(color));
+        }
+        std::lock_guard<std::mutex> lock(matches_mutex_);
+        matches_[match->id] = match;
+        open_seats_.push_back(match);
+    }
+    if (full) {
+        open_seats_.erase(std::remove(open_seats_.begin(), open_seats_.end(), match), open_seats_.end());
+    }
+    host_.wake(match->id);          // the next tick sends the board
+    KFC_INFO(Net, "Client joined match " << match->id << " as " << session->color);
+}
+
+// An unknown match closes the connection; there is nothing to watch
+void GameServer::watch(const SessionPtr& session, MatchHost::MatchId id) {
+    ServerMatchPtr match = find_match(id);
+    if (!match) throw std::runtime_error("no match " + std::to_string(id) + " to watch");
+    {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        session->match = id;
+        session->color = 'S';
+        std::string out;
+        net::write_welcome(out, id, 'S', 0);
+        send(*session, out);
+        match->watchers.push_back(session);
+    }
+    host_.wake(id);
+    KFC_INFO(Net, "Spectator joined match " << id);
+}
+
+void GameServer::receive_command(Session& session, uint32_t seq, Command cmd) {
+    const char* problem = session.match == 0 ? "not in a match"
+                        : session.color == 'S' ? "spectating"
+                        : check_command(cmd, session.color);
+    ServerMatchPtr match = problem ? nullptr : find_match(session.match);
+    if (!problem && !match) problem = "match closed";
+    if (problem) {
+        reject(session, seq, problem);
+        return;
+    }
+
+    cmd.timestamp = host_.time_ms(session.match);
+    cmd.player_id = session.color == 'W' ? 1 : 2;
+    SessionPtr self;
+    {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        self = match->seats[seat_of(session.color)];
+        match->inbox.push_back({std::move(cmd), seq, self});
+    }
+    host_.wake(session.match);
+}
+
+void GameServer::reject(Session& session, uint32_t seq, const char* reason) {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    std::string out;
+    net::write_reject(out, seq, reason);
+    send(session, out);
+}
+
+// nullptr when a client with seat 'color' may send it
+const char* GameServer::check_command(const Command& cmd, char color) {
+    if (cmd.piece_id.empty()) {
+        // Player controls: own cursor, or the promotion choice (whose it is
+        // depends on the board: check_in_game)
+        if (cmd.type.rfind("white_", 0) == 0) return color == 'W' ? nullptr : "not your cursor";
+        if (cmd.type.rfind("black_", 0) == 0) return color == 'B' ? nullptr : "not your cursor";
+        if (cmd.type.rfind("promote_", 0) == 0) return nullptr;
+        return "unknown control";
+    }
+    // Other types ("done", ...) are the pieces' own transitions
+    size_t params = cmd.type == "move" ? 2 : cmd.type == "jump" ? 1 : 0;
+    if (params == 0) return "unknown command";
+    if (cmd.piece_id.size() < 2 || cmd.piece_id[1] != color) return "not your piece";
+    if (cmd.params.size() != params) return "bad params";
+    for (const auto& cell : cmd.params) {
+        if (net::cell_code(cell) == net::kNoCell) return "cell off the board";
+    }
+    return nullptr;
+}
+
+// The game checks again when it applies the command; this answers the
+// sender instead of dropping it silently
+const char* GameServer::check_in_game(const Command& cmd, const Game& game) {
+    if (cmd.type.rfind("promote_", 0) == 0) {
+        // The game takes the choice from either player: only the pawn's owner
+        char seat = cmd.player_id == 1 ? 'W' : 'B';
+        return game.promoting_color() == seat ? nullptr : "not your promotion";
+    }
+    if (cmd.type != "jump") return nullptr;
+    for (const auto& piece : game.pieces) {
+        if (piece->id == cmd.piece_id) {
+            return Game::is_jump_valid(piece, cmd.params[0]) ? nullptr : "jump must be in place, when ready";
+        }
+    }
+    return "no such piece";
+}
+
+void GameServer::leave(const SessionPtr& session) {
+    sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), session), sessions_.end());
+    session_count_.fetch_sub(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(session->out_mutex);
+        session->dead = true;
+    }
+    if (session->match == 0) return;
+
+    ServerMatchPtr match = find_match(session->match);
+    if (!match) return;
+    if (session->color == 'S') {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        auto& watchers = match->watchers;
+        watchers.erase(std::remove(watchers.begin(), watchers.end(), session), watchers.end());
+        return;
+    }
+    bool empty = false;
+    {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        match->seats[seat_of(session->color)] = nullptr;
+        empty = !match->seats[0] && !match->seats[1];
+        // A deserted seat is open again unless the game is over
+        if (!empty && !match->over &&
+            std::find(open_seats_.begin(), open_seats_.end(), match) == open_seats_.end()) {
+            open_seats_.push_back(match);
+        }
+    }
+    if (empty) {
+        open_seats_.erase(std::remove(open_seats_.begin(), open_seats_.end(), match), open_seats_.end());
+        host_.close_match(match->id);
+        std::lock_guard<std::mutex> lock(matches_mutex_);
+        matches_.erase(match->id);
+    }
+    KFC_INFO(Net, "Client left match " << session->match);
+}
+
+// ---------------------------------------------------------------------------
+void GameServer::before_tick(MatchHost::MatchId id, Game& game, int now_ms) {
+    ServerMatchPtr match = find_match(id);
+    if (!match) return;
+    {
+        std::lock_guard<std::mutex> lock(match->mutex);
+        std::swap(match->applying, match->inbox);
+    }
+    auto& batch = match->applying;
+    batch.erase(std::remove_if(batch.begin(), batch.end(), [&](const ServerMatch::Pending& pending) {
+        const char* problem = check_in_game(pending.cmd, game);
+        if (problem) reject(*pending.from, pending.seq, problem);
+        return problem != nullptr;
+    }), batch.end());
+    for (auto& pending : batch) {
+        // Stamped while 'now' was taken: still this tick's
+        pending.cmd.timestamp = std::min(pending.cmd.timestamp, now_ms);
+        game.enqueue_command(pending.cmd);
+    }
+    commands_.fetch_add(match->applying.size(), std::memory_order_relaxed);
+}
+
+void GameServer::after_tick(MatchHost::MatchId id, Game& game, int now_ms) {
+    ServerMatchPtr match = find_match(id);
+    if (!match) return;
+
+    net::TickFrame& frame = match->frame;
+    frame.tick = ++match->ticks;
+    frame.time_ms = now_ms;
+    frame.hash = game.board_checksum();
+    auto& board = match->board;
+    board.clear();
+    for (const auto& piece : game.pieces) {
+        auto it = match->id_index.find(piece->id);
+        if (it == match->id_index.end()) {
+            it = match->id_index.emplace(piece->id, static_cast<uint32_t>(match->ids.size())).first;
+            match->ids.push_back(piece->id);
+        }
+        board.push_back(net::visible_piece(*piece, it->second));
+    }
+    std::sort(board.begin(), board.end(),
+              [](const net::VisiblePiece& a, const net::VisiblePiece& b) { return a.handle < b.handle; });
+    match->snapshot.set(board, now_ms);
+    bool keyframe_tick = config_.keyframe_interval > 0 && frame.tick % config_.keyframe_interval == 0;
+    char winner = game.winner();
+
+    std::lock_guard<std::mutex> lock(match->mutex);
+    auto send_tick = [&](Session& viewer) {
+        std::string& out = match->out;
+        out.clear();
+        if (viewer.known_ids < match->ids.size()) {
+            net::write_ids(out, static_cast<uint32_t>(viewer.known_ids), match->ids, viewer.known_ids, match->ids.size());
+            viewer.known_ids = match->ids.size();
+        }
+        frame.acks.clear();
+        for (const auto& pending : match->applying) {
+            if (pending.from.get() == &viewer) frame.acks.push_back(pending.seq);
+        }
+        bool keyframe = keyframe_tick || viewer.needs_keyframe;
+        size_t start = out.size();
+        net::write_tick(out, frame, keyframe ? match->snapshot.keyframe() : match->snapshot.delta());
+        size_t tick_size = out.size() - start;
+        viewer.needs_keyframe = false;
+        // Per viewer: spectators and seats that arrive after the end still get it
+        if (winner && !viewer.told_game_over) {
+            net::write_game_over(out, winner);
+            viewer.told_game_over = true;
+        }
+        send(viewer, out);
+        ticks_sent_.fetch_add(1, std::memory_order_relaxed);
+        tick_bytes_.fetch_add(tick_size, std::memory_order_relaxed);
+        if (keyframe) keyframes_.fetch_add(1, std::memory_order_relaxed);
+    };
+    for (auto& seat : match->seats) {
+        if (seat) send_tick(*seat);
+    }
+    for (auto& watcher : match->watchers) {
+        send_tick(*watcher);
+    }
+    match->applying.clear();
+    if (winner) {
+        match->over = true;
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "MatchHost.hpp"
+#include "NetProtocol.hpp"
+#include "SnapshotCodec.hpp"
+#include "Socket.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct GameServerConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 0;              // 0: any free port (see GameServer::port)
+    MatchHostConfig matches;
+    int keyframe_interval = 600;    // ticks between full boards (besides joins)
+};
+
+// ---------------------------------------------------------------------------
+// Authoritative network play (see NetProtocol for the wire format). Clients
+// join a seat; two seats make a match on a MatchHost, which owns the only
+// Game. Spectators watch a match by id and cannot send commands. A network thread polls every socket: it checks that a command
+// belongs to the sender's seat, stamps it with the match time and leaves it
+// in the match's inbox. Right before the match's next tick the whole inbox
+// is handed to the game, which applies it in timestamp order; after the
+// tick every seat gets a Tick frame with the position hash, the sequence
+// numbers of its own commands in that batch and the board: a keyframe for a
+// newcomer and every keyframe_interval ticks, else only the pieces that
+// changed (SnapshotEncoder), which is one encoding shared by all viewers.
+//
+// Frames are written straight from the tick's worker when the socket takes
+// them; the rest waits in the seat's outbox for the network thread. A client
+// that lets kMaxOutbox bytes pile up is dropped.
+// ---------------------------------------------------------------------------
+class GameServer {
+public:
+    static constexpr size_t kMaxOutbox = 1 << 20;
+
+    explicit GameServer(GameServerConfig config = {});
+    ~GameServer();
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Binds and starts serving; throws std::runtime_error
+    void start();
+    void stop();
+    uint16_t port() const { return port_; }
+
+    struct Stats {
+        uint64_t sessions{0};       // connected now
+        uint64_t matches{0};        // open now
+        uint64_t commands{0};       // handed to games
+        uint64_t rejected{0};
+        uint64_t ticks_sent{0};     // Tick frames
+        uint64_t tick_bytes{0};     // their size
+        uint64_t keyframes{0};      // ticks sent with a full board
+        uint64_t bytes_in{0};
+        uint64_t bytes_out{0};
+    };
+    Stats stats() const;
+    MatchHost::Stats host_stats() const { return host_.stats(); }
+
+    // Why a client's command is refused (nullptr: accepted); the reason goes
+    // back in a Reject frame. check_command needs only the sender's seat,
+    // check_in_game the board as of the last tick (match worker)
+    static const char* check_command(const Command& cmd, char color);
+    static const char* check_in_game(const Command& cmd, const Game& game);
+
+private:
+    struct Session;
+    struct ServerMatch;
+    using SessionPtr = std::shared_ptr<Session>;
+    using ServerMatchPtr = std::shared_ptr<ServerMatch>;
+
+    GameServerConfig config_;
+    MatchHost host_;
+    Socket listener_;
+    uint16_t port_{0};
+    std::thread network_thread_;
+    std::atomic<bool> running_{false};
+
+    std::vector<SessionPtr> sessions_;              // network thread
+    std::vector<ServerMatchPtr> open_seats_;        // network thread: matches missing a player
+
+    mutable std::mutex matches_mutex_;
+    std::unordered_map<MatchHost::MatchId, ServerMatchPtr> matches_;    // guarded by matches_mutex_
+
+    std::atomic<uint64_t> session_count_{0};
+    std::atomic<uint64_t> commands_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> ticks_sent_{0};
+    std::atomic<uint64_t> tick_bytes_{0};
+    std::atomic<uint64_t> keyframes_{0};
+    std::atomic<uint64_t> bytes_in_{0};
+    std::atomic<uint64_t> bytes_out_{0};
+
+    // --- network thread ---
+    void network_loop();
+    void accept_all();
+    bool read(const SessionPtr& session);
+    void flush(Session& session);
+    void handle(const SessionPtr& session, const net::FrameBuffer::Frame& frame);
+    void join(const SessionPtr& session, char color);
+    void watch(const SessionPtr& session, MatchHost::MatchId id);
+    void receive_command(Session& session, uint32_t seq, Command cmd);
+    void leave(const SessionPtr& session);
+    void reject(Session& session, uint32_t seq, const char* reason);
+
+    // --- match workers ---
+    void before_tick(MatchHost::MatchId id, Game& game, int now_ms);
+    void after_tick(MatchHost::MatchId id, Game& game, int now_ms);
+
+    ServerMatchPtr find_match(MatchHost::MatchId id) const;
+    // Any thread; false once the session is being dropped
+    bool send(Session& session, const std::string& bytes);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "img/Img.hpp"
+#include "ScoreManager.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class GameState {
+    STARTING,    // מציג מסך התחלה
+    PLAYING,     // משחק רגיל
+    GAME_OVER    // מציג מסך סיום
+};
+
+// ---------------------------------------------------------------------------
+// Everything the renderer needs from one simulation tick. Built by the
+// simulation thread and handed to the render thread through a TripleBuffer;
+// once published it is never modified. Images are shared, not copied, and
+// text that rarely changes (move lists, profiler table) is shared by pointer
+// until it does.
+// ---------------------------------------------------------------------------
+struct GameSnapshot {
+    using Lines = std::shared_ptr<const std::vector<std::string>>;
+
+    struct PieceView {
+        const void* key{nullptr};   // piece identity across snapshots
+        std::string id;
+        std::string state;          // state machine state name
+        std::pair<int,int> cell{0, 0};
+        int x{0}, y{0};             // board pixels
+        bool moving{false};         // position is continuous (move/jump)
+        size_t frame{0};            // animation frame index
+        ImgPtr img;                 // that frame
+    };
+
+    uint64_t seq{0};
+    int time_ms{0};
+    std::chrono::steady_clock::time_point published;
+
+    GameState state{GameState::STARTING};
+    std::vector<PieceView> pieces;
+
+    std::pair<int,int> white_cursor{0, 0};
+    std::pair<int,int> black_cursor{0, 0};
+    std::pair<int,int> selected{-1, -1};     // {-1,-1} when nothing is selected
+    bool promoting{false};
+
+    PlayerScore white_score;
+    PlayerScore black_score;
+    Lines white_moves;
+    Lines black_moves;
+    std::string text;           // TextManager banner
+    std::string winner;
+    bool winner_shown{false};   // the winner banner is up; any key exits
+    Lines profile;              // simulation phase timings, when the overlay is on
+};
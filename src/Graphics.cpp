@@ -7,11 +7,18 @@
 #include <iostream>
 
 Graphics::Graphics(const std::string& sprites_folder,
-	std::pair<int, int> cell_size,
+	std::pair<int, int> /*cell_size*/,
 	ImgFactoryPtr img_factory,
 	bool loop_, double fps_)
 
-	: loop(loop_), fps(fps_), frame_duration_ms(1000.0 / fps_) {
+	: Graphics(load_frames(sprites_folder, img_factory), loop_, fps_) {}
+
+Graphics::Graphics(Frames frames_, bool loop_, double fps_)
+	: frames(frames_ ? std::move(frames_) : std::make_shared<const std::vector<ImgPtr>>()),
+	  loop(loop_), fps(fps_), frame_duration_ms(1000.0 / fps_) {}
+
+Graphics::Frames Graphics::load_frames(const std::string& sprites_folder, ImgFactoryPtr img_factory) {
+    auto frames = std::make_shared<std::vector<ImgPtr>>();
 
     namespace fs = std::filesystem;
     if(!sprites_folder.empty() && img_factory) {
@@ -39,11 +46,12 @@ Graphics::Graphics(const std::string& sprites_folder,
                 const auto& p = pngs[i];
                 auto img_ptr = img_factory->load(p.string(), {80, 80});
                 if(img_ptr) {
-                    frames.push_back(img_ptr);
+                    frames->push_back(img_ptr);
                 }
             }
         }
     }
+    return frames;
 }
 
 void Graphics::reset(const Command& cmd) {
@@ -52,7 +60,7 @@ void Graphics::reset(const Command& cmd) {
 }
 
 void Graphics::update(int now_ms) {
-	if (frames.empty()) return;
+	if (frames->empty()) return;
 	
 	int elapsed = now_ms - start_ms;
 	double frames_passed_exact = elapsed / frame_duration_ms;
@@ -61,14 +69,14 @@ void Graphics::update(int now_ms) {
 
 	
 	if (loop) {
-		cur_frame = frames_passed % frames.size();
+		cur_frame = frames_passed % frames->size();
 	} else {
-		cur_frame = std::min(frames_passed, frames.size() - 1);
+		cur_frame = std::min(frames_passed, frames->size() - 1);
 	}
 }
 
 const ImgPtr Graphics::get_img() const {
-	if (frames.empty()) throw std::runtime_error("Graphics has no frames loaded");
+	if (frames->empty()) throw std::runtime_error("Graphics has no frames loaded");
 	// Frame display - removed spam
-	return frames[cur_frame];
+	return (*frames)[cur_frame];
 }
\ No newline at end of file
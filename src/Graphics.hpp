@@ -7,22 +7,30 @@
 
 class Graphics {
 public:
+	using Frames = std::shared_ptr<const std::vector<ImgPtr>>;
+
 	Graphics(const std::string& sprites_folder,
 		std::pair<int, int> cell_size,
 		ImgFactoryPtr img_factory,
 		bool loop = true,
 		double fps = 0.2);
 
+	// Shares already loaded frames (piece type prototypes)
+	Graphics(Frames frames, bool loop = true, double fps = 0.2);
+
+	// Sprites of a folder, in numeric order (1.png, 2.png, ...)
+	static Frames load_frames(const std::string& sprites_folder, ImgFactoryPtr img_factory);
+
 	void reset(const Command& cmd);
 	void update(int now_ms);
 	const ImgPtr get_img() const;
 
 	// Test helpers ---------------------------------------------------------
 	size_t current_frame() const { return cur_frame; }
-	void set_frames(const std::vector<ImgPtr>& new_frames) { frames = new_frames; }
+	void set_frames(const std::vector<ImgPtr>& new_frames) { frames = std::make_shared<const std::vector<ImgPtr>>(new_frames); }
 
 private:
-	std::vector<ImgPtr> frames;
+	Frames frames;
 	bool loop{ true };
 	double fps{ 0.2 };
 	int start_ms{ 0 };
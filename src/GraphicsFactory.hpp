@@ -4,27 +4,38 @@
 #include <memory>
 #include <string>
 #include "img/ImgFactory.hpp"
+#include "img/SpriteCache.hpp"
 #include "nlohmann/json.hpp"
 
 
 // Simple GraphicsFactory that forwards an image loader placeholder to
 // Graphics.  In this head-less C++ port, the img_loader is unused but the
 // factory mirrors the Python API expected by the unit tests.
+// Sprite loads go through the process-wide SpriteCache, so identical frames
+// (same file, same size) are decoded once and shared by every piece.
 class GraphicsFactory {
 public:
     explicit GraphicsFactory(ImgFactoryPtr factory_ptr = nullptr)
-        : img_factory(factory_ptr) {}
+        : img_factory(CachingImgFactory::wrap(factory_ptr)) {}
 
     std::shared_ptr<Graphics> load(const std::string& sprites_dir,
                                    const nlohmann::json& cfg,
                                    std::pair<int,int> cell_size) const {
+        (void)cell_size; // unused for now
+        return create(load_frames(sprites_dir), cfg);
+    }
+
+    // Decoded sprites of one folder, shareable between Graphics instances
+    Graphics::Frames load_frames(const std::string& sprites_dir) const {
+        return Graphics::load_frames(sprites_dir, img_factory);
+    }
+
+    // New animation runtime over shared frames - no filesystem access
+    std::shared_ptr<Graphics> create(Graphics::Frames frames, const nlohmann::json& cfg) const {
         // Extract graphics settings from config
         bool loop = cfg.value("is_loop", true);
         double fps = cfg.value("frames_per_sec", 3.0); // Slower default FPS
-        
-        auto gfx = std::make_shared<Graphics>(sprites_dir, cell_size, img_factory, loop, fps);
-        (void)cell_size; // unused for now
-        return gfx;
+        return std::make_shared<Graphics>(std::move(frames), loop, fps);
     }
 private:
     ImgFactoryPtr img_factory;
@@ -0,0 +1,161 @@
+#include "Log.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+LogLevel level_from_env() {
+    const char* env = std::getenv("KFC_LOG_LEVEL");
+    if (!env) return LogLevel::Info;
+    if (!std::strcmp(env, "trace")) return LogLevel::Trace;
+    if (!std::strcmp(env, "debug")) return LogLevel::Debug;
+    if (!std::strcmp(env, "warn"))  return LogLevel::Warn;
+    if (!std::strcmp(env, "error")) return LogLevel::Error;
+    if (!std::strcmp(env, "off"))   return LogLevel::Off;
+    return LogLevel::Info;
+}
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : sink_(&std::cout) {
+    set_level(level_from_env());
+}
+
+Logger::~Logger() {
+    if (running_.exchange(false) && writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_.notify_one();
+        }
+        writer_.join(); // the writer drains what is left before exiting
+    }
+}
+
+// ---------------------------------------------------------------------------
+void Logger::set_category_enabled(LogCategory category, bool on) {
+    unsigned bit = 1u << static_cast<unsigned>(category);
+    if (on) category_mask_.fetch_or(bit, std::memory_order_relaxed);
+    else    category_mask_.fetch_and(~bit, std::memory_order_relaxed);
+}
+
+void Logger::set_sink(std::ostream* sink) {
+    flush();
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink_ = sink ? sink : &std::cout;
+}
+
+void Logger::write(LogLevel level, LogCategory category, std::string text) {
+    std::call_once(started_, [this] { start(); });
+
+    if (ring_.try_push(Record{level, category, std::move(text)})) {
+        pushed_.fetch_add(1);
+        // Only a parked writer needs the lock and the signal
+        if (parked_.load()) {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            wake_.notify_one();
+        }
+        return;
+    }
+
+    // Ring full: never lose warnings/errors, drop chatter
+    if (level >= LogLevel::Warn) {
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        *sink_ << '[' << level_name(level) << "][" << category_name(category) << "] " << text << '\n';
+    } else {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    if (!running_.load(std::memory_order_acquire)) return;
+    while (written_.load(std::memory_order_acquire) < pushed_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+// ---------------------------------------------------------------------------
+void Logger::start() {
+    running_.store(true, std::memory_order_release);
+    writer_ = std::thread([this] { drain_loop(); });
+}
+
+void Logger::drain_loop() {
+    std::string batch;
+    size_t reported_drops = 0;
+    while (running_.load(std::memory_order_acquire)) {
+        if (drain_once(batch) > 0) continue;
+
+        size_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            std::lock_guard<std::mutex> lock(sink_mutex_);
+            *sink_ << "[WARN][log] " << (drops - reported_drops) << " messages dropped" << std::endl;
+            reported_drops = drops;
+        }
+
+        // Park until a producer pushes. parked_ is set before pushed_ is
+        // re-read and write() bumps pushed_ before reading parked_, so one
+        // of the two always sees the other
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        parked_.store(true);
+        wake_.wait(lock, [this] {
+            return written_.load() < pushed_.load() || !running_.load();
+        });
+        parked_.store(false, std::memory_order_relaxed);
+    }
+    while (drain_once(batch) > 0) {}
+}
+
+// Write everything currently queued as one block; returns records written
+size_t Logger::drain_once(std::string& batch) {
+    batch.clear();
+    size_t count = 0;
+    Record record;
+    while (count < ring_.capacity() && ring_.try_pop(record)) {
+        batch += '[';
+        batch += level_name(record.level);
+        batch += "][";
+        batch += category_name(record.category);
+        batch += "] ";
+        batch += record.text;
+        batch += '\n';
+        ++count;
+    }
+    if (count > 0) {
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        sink_->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        sink_->flush();
+        written_.fetch_add(count, std::memory_order_release);
+    }
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+const char* Logger::level_name(LogLevel level) {
+    switch (level) {
+    case LogLevel::Trace: return "TRACE";
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info:  return "INFO";
+    case LogLevel::Warn:  return "WARN";
+    case LogLevel::Error: return "ERROR";
+    default:              return "OFF";
+    }
+}
+
+const char* Logger::category_name(LogCategory category) {
+    switch (category) {
+    case LogCategory::Game:    return "game";
+    case LogCategory::Input:   return "input";
+    case LogCategory::Physics: return "physics";
+    case LogCategory::Capture: return "capture";
+    case LogCategory::Events:  return "events";
+    case LogCategory::Render:  return "render";
+    case LogCategory::Audio:   return "audio";
+    case LogCategory::Net:     return "net";
+    default:                   return "general";
+    }
+}
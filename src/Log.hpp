@@ -0,0 +1,105 @@
+#pragma once
+
+#include "MpscRing.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// Asynchronous leveled logger. KFC_LOG formats the message on the calling
+// thread only if its level and category are enabled, then pushes it into a
+// lock-free ring; a background thread writes batches to the sink (stdout
+// by default) and flushes once per batch instead of once per line. While the
+// ring is empty the writer sleeps on a condition variable.
+//
+// Levels below KFC_LOG_MIN_LEVEL (0=trace ... 4=error, set from CMake) are
+// removed at compile time. The runtime level defaults to info and can be
+// changed with set_level() or the KFC_LOG_LEVEL environment variable
+// (trace/debug/info/warn/error/off).
+// ---------------------------------------------------------------------------
+
+#ifndef KFC_LOG_MIN_LEVEL
+#define KFC_LOG_MIN_LEVEL 1
+#endif
+
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Off = 5 };
+
+enum class LogCategory { General, Game, Input, Physics, Capture, Events, Render, Audio, Net, Count };
+
+class Logger {
+public:
+    static Logger& instance();
+
+    bool enabled(LogLevel level, LogCategory category) const {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed) &&
+               (category_mask_.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(category)));
+    }
+
+    void set_level(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    void set_category_enabled(LogCategory category, bool on);
+    // Destination for the writer thread (not owned); nullptr restores stdout
+    void set_sink(std::ostream* sink);
+
+    void write(LogLevel level, LogCategory category, std::string text);
+
+    // Block until everything logged so far has reached the sink
+    void flush();
+
+    size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static const char* level_name(LogLevel level);
+    static const char* category_name(LogCategory category);
+
+    ~Logger();
+
+private:
+    Logger();
+
+    struct Record {
+        LogLevel level{LogLevel::Info};
+        LogCategory category{LogCategory::General};
+        std::string text;
+    };
+
+    MpscRing<Record, 4096> ring_;
+    std::atomic<int> level_{static_cast<int>(LogLevel::Info)};
+    std::atomic<unsigned> category_mask_{~0u};
+    std::atomic<size_t> pushed_{0};
+    std::atomic<size_t> written_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> parked_{false};   // writer is (about to be) waiting on wake_
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+
+    std::mutex sink_mutex_;
+    std::ostream* sink_;
+    std::once_flag started_;
+    std::thread writer_;
+
+    void start();
+    void drain_loop();
+    size_t drain_once(std::string& batch);
+};
+
+#define KFC_LOG(level, category, expr)                                                  \
+    do {                                                                                \
+        if constexpr (static_cast<int>(level) >= KFC_LOG_MIN_LEVEL) {                   \
+            if (Logger::instance().enabled(level, category)) {                          \
+                std::ostringstream kfc_log_os_;                                         \
+                kfc_log_os_ << expr;                                                    \
+                Logger::instance().write(level, category, kfc_log_os_.str());           \
+            }                                                                           \
+        }                                                                               \
+    } while (0)
+
+#define KFC_TRACE(category, expr) KFC_LOG(LogLevel::Trace, LogCategory::category, expr)
+#define KFC_DEBUG(category, expr) KFC_LOG(LogLevel::Debug, LogCategory::category, expr)
+#define KFC_INFO(category, expr)  KFC_LOG(LogLevel::Info,  LogCategory::category, expr)
+#define KFC_WARN(category, expr)  KFC_LOG(LogLevel::Warn,  LogCategory::category, expr)
+#define KFC_ERROR(category, expr) KFC_LOG(LogLevel::Error, LogCategory::category, expr)
@@ -0,0 +1,185 @@
+#include "Loopback.hpp"
+#include "NetClient.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct ClientResult {
+    uint64_t sent = 0;
+    uint64_t acked = 0;
+    uint64_t rejected = 0;
+    uint64_t ticks = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+    std::vector<double> latencies_ms;
+};
+
+// An idle pawn of ours with a free cell ahead, as a move
+bool pawn_advance(const NetClient& client, std::mt19937& rng, Command& cmd) {
+    const auto& ids = client.ids();
+    bool occupied[64] = {};
+    std::vector<const net::VisiblePiece*> pawns;
+    for (const auto& p : client.pieces()) {
+        if (p.from != net::kNoCell) occupied[p.from] = true;
+        if (p.to != net::kNoCell) occupied[p.to] = true;
+        if (p.handle >= ids.size()) continue;
+        const std::string& id = ids[p.handle];
+        if (id.size() >= 2 && id[0] == 'P' && id[1] == client.color() && p.state == net::kIdle) {
+            pawns.push_back(&p);
+        }
+    }
+    int step = client.color() == 'W' ? -8 : 8;
+    pawns.erase(std::remove_if(pawns.begin(), pawns.end(), [&](const net::VisiblePiece* p) {
+        int ahead = p->to + step;
+        return p->to == net::kNoCell || ahead < 0 || ahead >= 64 || occupied[ahead];
+    }), pawns.end());
+    if (pawns.empty()) return false;
+
+    const net::VisiblePiece& pawn = *pawns[std::uniform_int_distribution<size_t>(0, pawns.size() - 1)(rng)];
+    int from = pawn.to, to = pawn.to + step;
+    cmd = Command(0, ids[pawn.handle], "move", {{from / 8, from % 8}, {to / 8, to % 8}});
+    return true;
+}
+
+void play(uint16_t port, char color, const LoopbackConfig& config, Clock::time_point end,
+          unsigned seed, ClientResult& result) {
+    NetClient client("127.0.0.1", port, color);
+    std::mt19937 rng(seed);
+    std::unordered_map<uint32_t, Clock::time_point> in_flight;
+
+    client.on_tick = [&](const net::TickFrame& tick) {
+        ++result.ticks;
+        auto now = Clock::now();
+        for (uint32_t seq : tick.acks) {
+            auto it = in_flight.find(seq);
+            if (it == in_flight.end()) continue;
+            result.latencies_ms.push_back(std::chrono::duration<double, std::milli>(now - it->second).count());
+            in_flight.erase(it);
+            ++result.acked;
+        }
+    };
+    client.on_reject = [&](uint32_t seq, const std::string&) {
+        in_flight.erase(seq);
+        ++result.rejected;
+    };
+
+    const std::string side = color == 'W' ? "white_" : "black_";
+    const auto interval = std::chrono::milliseconds(config.command_interval_ms);
+    auto next_send = Clock::now() + std::chrono::milliseconds(rng() % std::max(1, config.command_interval_ms));
+    bool left = false;
+    while (Clock::now() < end && !client.winner()) {
+        auto now = Clock::now();
+        if (now >= next_send) {
+            Command cmd;
+            if (!pawn_advance(client, rng, cmd)) {
+                cmd = Command(0, "", side + (left ? "left" : "right"), {});
+                left = !left;
+            }
+            in_flight[client.send(cmd)] = Clock::now();
+            ++result.sent;
+            next_send += interval;
+            continue;
+        }
+        int wait = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(next_send - now).count());
+        if (!client.poll(std::max(1, wait))) break;
+    }
+    // Acks for the last commands
+    auto drain_end = Clock::now() + std::chrono::milliseconds(500);
+    while (!in_flight.empty() && Clock::now() < drain_end && client.poll(10)) {
+    }
+    result.bytes_sent = client.bytes_sent();
+    result.bytes_received = client.bytes_received();
+}
+
+// Follows one match until the players are done
+void spectate(uint16_t port, uint32_t match_id, Clock::time_point end, ClientResult& result) {
+    NetClient client("127.0.0.1", port, NetClient::Spectate{match_id});
+    client.on_tick = [&](const net::TickFrame&) { ++result.ticks; };
+    while (Clock::now() < end && !client.winner() && client.poll(10)) {
+    }
+    result.bytes_sent = client.bytes_sent();
+    result.bytes_received = client.bytes_received();
+}
+
+double percentile(const std::vector<double>& sorted, int pct) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, sorted.size() * pct / 100)];
+}
+}
+
+LoopbackReport run_loopback(const LoopbackConfig& config) {
+    GameServer server(config.server);
+    server.start();
+
+    int clients = std::max(1, config.matches) * 2;
+    std::vector<ClientResult> results(clients);
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    auto end = start + std::chrono::seconds(config.seconds);
+    for (int i = 0; i < clients; ++i) {
+        char color = i % 2 == 0 ? 'W' : 'B';
+        threads.emplace_back([&, i, color] {
+            try {
+                play(server.port(), color, config, end, 1234u + i, results[i]);
+            } catch (const std::exception& e) {
+                KFC_ERROR(Net, "Loopback client " << i << ": " << e.what());
+            }
+        });
+    }
+    // Spectators once every match is open (match ids count from 1)
+    std::vector<ClientResult> watched(config.spectators * std::max(1, config.matches));
+    while (server.stats().matches < static_cast<uint64_t>(config.matches) && Clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    for (size_t i = 0; i < watched.size(); ++i) {
+        auto match_id = static_cast<uint32_t>(i % std::max(1, config.matches) + 1);
+        threads.emplace_back([&, i, match_id] {
+            try {
+                spectate(server.port(), match_id, end, watched[i]);
+            } catch (const std::exception& e) {
+                KFC_ERROR(Net, "Loopback spectator " << i << ": " << e.what());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    LoopbackReport report;
+    report.wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+    report.clients = clients;
+    std::vector<double> latencies;
+    for (const auto& r : results) {
+        report.commands_sent += r.sent;
+        report.commands_acked += r.acked;
+        report.rejected += r.rejected;
+        report.ticks_received += r.ticks;
+        report.bytes_to_server += r.bytes_sent;
+        report.bytes_to_clients += r.bytes_received;
+        latencies.insert(latencies.end(), r.latencies_ms.begin(), r.latencies_ms.end());
+    }
+    for (const auto& r : watched) {
+        report.spectator_ticks += r.ticks;
+        report.bytes_to_spectators += r.bytes_received;
+    }
+    report.spectators = static_cast<int>(watched.size());
+    GameServer::Stats s = server.stats();
+    report.tick_frames = s.ticks_sent;
+    report.tick_bytes = s.tick_bytes;
+    report.keyframes = s.keyframes;
+    std::sort(latencies.begin(), latencies.end());
+    report.latency_p50_ms = percentile(latencies, 50);
+    report.latency_p99_ms = percentile(latencies, 99);
+    report.latency_max_ms = latencies.empty() ? 0 : latencies.back();
+    server.stop();
+    return report;
+}
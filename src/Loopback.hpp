@@ -0,0 +1,45 @@
+#pragma once
+
+#include "GameServer.hpp"
+#include <cstdint>
+
+struct LoopbackConfig {
+    GameServerConfig server;        // port 0: any free one
+    int matches = 4;                // two scripted clients each
+    int seconds = 5;
+    int command_interval_ms = 50;   // per client
+    int spectators = 0;             // per match
+};
+
+struct LoopbackReport {
+    int clients = 0;
+    uint64_t commands_sent = 0;
+    uint64_t commands_acked = 0;
+    uint64_t rejected = 0;
+    uint64_t ticks_received = 0;
+    uint64_t bytes_to_server = 0;
+    uint64_t bytes_to_clients = 0;
+    int spectators = 0;
+    uint64_t spectator_ticks = 0;
+    uint64_t bytes_to_spectators = 0;
+    // Tick frames as the server sent them (players and spectators)
+    uint64_t tick_frames = 0;
+    uint64_t tick_bytes = 0;
+    uint64_t keyframes = 0;
+    double wall_s = 0;
+    // Send to the Tick that acked it, as the client sees it
+    double latency_p50_ms = 0;
+    double latency_p99_ms = 0;
+    double latency_max_ms = 0;
+
+    double commands_per_s() const { return wall_s > 0 ? commands_acked / wall_s : 0; }
+    double ticks_per_s() const { return wall_s > 0 ? ticks_received / wall_s : 0; }
+    double bytes_per_tick() const { return tick_frames ? static_cast<double>(tick_bytes) / tick_frames : 0; }
+};
+
+// Starts a GameServer on localhost and plays 'matches' matches against it
+// with scripted clients, one thread each: every interval a client advances
+// one of its idle pawns a cell, or moves its cursor when none can. Latency
+// is measured per command, from send() to the Tick that applied it.
+// Spectators, if any, join each match once it is open.
+LoopbackReport run_loopback(const LoopbackConfig& config);
@@ -0,0 +1,175 @@
+#include "MatchHost.hpp"
+#include "Game.hpp"
+#include "Log.hpp"
+#include "img/MockImg.hpp"
+
+#include <algorithm>
+
+// Headless: sprites are not decoded, and nothing here is drawn
+MatchHost::MatchHost(MatchHostConfig config)
+    : config_(std::move(config)),
+      img_factory_(std::make_shared<MockImgFactory>()),
+      board_(80, 80, 8, 8, img_factory_->load(config_.pieces_root + "board.png", {640, 640})) {
+    if (config_.tick_ms <= 0) {
+        throw std::invalid_argument("Match tick must be positive");
+    }
+    factory_ = std::make_shared<PieceFactory>(board_, config_.pieces_root, GraphicsFactory(img_factory_));
+
+    // Every type any match can spawn is loaded now, so workers only hit the
+    // registry's cache
+    std::vector<std::string> types;
+    for (const char* type : {"P", "N", "B", "R", "Q", "K"}) {
+        for (const char* color : {"W", "B"}) {
+            if (fs::is_directory(fs::path(config_.pieces_root) / (std::string(type) + color))) {
+                types.push_back(std::string(type) + color);
+            }
+        }
+    }
+    factory_->preload(types);
+}
+
+MatchHost::~MatchHost() {
+    stop();
+}
+
+void MatchHost::start() {
+    if (running_.exchange(true)) return;
+    pool_ = std::make_unique<WorkStealingPool>(config_.threads);
+    host_thread_ = std::thread([this] { host_loop(); });
+    KFC_INFO(Game, "Match host: " << pool_->size() << " workers, " << config_.tick_ms << " ms ticks");
+}
+
+void MatchHost::stop() {
+    if (!running_.exchange(false)) return;
+    if (host_thread_.joinable()) {
+        host_thread_.join();
+    }
+    pool_->wait_idle();
+    pool_.reset();
+}
+
+// ---------------------------------------------------------------------------
+MatchHost::MatchId MatchHost::open_match() {
+    auto match = std::make_shared<Match>();
+    match->game.reset(new Game(create_game(factory_, board_, config_.pieces_root + "board.csv", false)));
+    match->opened = std::chrono::steady_clock::now();
+    match->game->step_to(0);        // PLAYING on its virtual clock
+    match->quiet = match->game->is_quiet();
+
+    std::lock_guard<std::mutex> lock(matches_mutex_);
+    match->id = next_id_++;
+    matches_.push_back(match);
+    return match->id;
+}
+
+void MatchHost::close_match(MatchId id) {
+    std::lock_guard<std::mutex> lock(matches_mutex_);
+    // A tick in flight keeps its match alive until it returns
+    matches_.erase(std::remove_if(matches_.begin(), matches_.end(),
+                                  [id](const MatchPtr& m) { return m->id == id; }),
+                   matches_.end());
+}
+
+bool MatchHost::post(MatchId id, Command cmd) {
+    MatchPtr match = find(id);
+    if (!match) return false;
+    cmd.timestamp = match_time_ms(*match);
+    match->game->enqueue_command(cmd);
+    match->mail.store(true, std::memory_order_release);
+    return true;
+}
+
+bool MatchHost::wake(MatchId id) {
+    MatchPtr match = find(id);
+    if (!match) return false;
+    match->mail.store(true, std::memory_order_release);
+    return true;
+}
+
+int MatchHost::time_ms(MatchId id) const {
+    MatchPtr match = find(id);
+    return match ? match_time_ms(*match) : -1;
+}
+
+size_t MatchHost::match_count() const {
+    std::lock_guard<std::mutex> lock(matches_mutex_);
+    return matches_.size();
+}
+
+MatchHost::Stats MatchHost::stats() const {
+    Stats s;
+    s.ticks_run = ticks_run_.load(std::memory_order_relaxed);
+    s.ticks_skipped = ticks_skipped_.load(std::memory_order_relaxed);
+    s.ticks_late = ticks_late_.load(std::memory_order_relaxed);
+    s.steals = pool_ ? pool_->steals() : 0;
+    return s;
+}
+
+MatchHost::MatchPtr MatchHost::find(MatchId id) const {
+    std::lock_guard<std::mutex> lock(matches_mutex_);
+    // Ids only grow and matches are appended, so the list is sorted by id
+    auto it = std::lower_bound(matches_.begin(), matches_.end(), id,
+                               [](const MatchPtr& m, MatchId value) { return m->id < value; });
+    return it != matches_.end() && (*it)->id == id ? *it : nullptr;
+}
+
+int MatchHost::match_time_ms(const Match& match) {
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - match.opened).count());
+}
+
+// ---------------------------------------------------------------------------
+void MatchHost::host_loop() {
+    const auto step = std::chrono::milliseconds(config_.tick_ms);
+    auto next_tick = std::chrono::steady_clock::now();
+    std::vector<MatchPtr> due;
+
+    while (running_) {
+        {
+            std::lock_guard<std::mutex> lock(matches_mutex_);
+            for (const auto& match : matches_) {
+                bool mail = match->mail.load(std::memory_order_acquire);
+                if (match->quiet.load(std::memory_order_acquire) && !mail) {
+                    ticks_skipped_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                if (match->busy.exchange(true, std::memory_order_acq_rel)) {
+                    ticks_late_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                due.push_back(match);
+            }
+        }
+        for (auto& match : due) {
+            pool_->submit([this, match] { run_tick(match); });
+        }
+        due.clear();
+
+        next_tick += step;
+        auto now = std::chrono::steady_clock::now();
+        if (next_tick < now) {
+            next_tick = now;    // overloaded: no catch-up burst
+        }
+        std::this_thread::sleep_until(next_tick);
+    }
+}
+
+void MatchHost::run_tick(const MatchPtr& match) {
+    // Clear first: a command posted during this tick wakes the next one
+    match->mail.store(false, std::memory_order_release);
+    int now = match_time_ms(*match);
+    try {
+        if (before_tick_) {
+            before_tick_(match->id, *match->game, now);
+        }
+        match->game->step_to(now);
+        if (observer_) {
+            observer_(match->id, *match->game, now);
+        }
+    } catch (const std::exception& e) {
+        KFC_ERROR(Game, "Match " << match->id << " tick failed: " << e.what());
+    }
+    match->quiet.store(match->game->is_quiet(), std::memory_order_release);
+    ticks_run_.fetch_add(1, std::memory_order_relaxed);
+    match->busy.store(false, std::memory_order_release);
+}
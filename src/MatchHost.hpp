@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Command.hpp"
+#include "img/ImgFactory.hpp"
+#include "WorkStealingPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Game;
+class PieceFactory;
+
+struct MatchHostConfig {
+    std::string pieces_root = "pieces/";
+    size_t threads = 0;         // tick workers; 0: one per hardware thread
+    int tick_ms = 16;
+};
+
+// ---------------------------------------------------------------------------
+// Many headless matches in one process. Each match is a Game on its own
+// virtual clock (ms since the match opened); a host thread deals their
+// ticks as tasks to a work-stealing pool once per tick_ms. A match is never
+// ticked by two workers at once, and a quiet one (nothing moving, resting
+// or queued, see Game::is_quiet) is skipped until a command arrives, so an
+// idle match costs a flag check per host tick and no thread of its own.
+//
+// Commands go through post(), the match's mailbox, from any thread; they
+// are stamped with the match time on arrival. Every match shares one board
+// image and one prototype registry (move rules, sprites) loaded at startup
+// and only read afterwards.
+// ---------------------------------------------------------------------------
+class MatchHost {
+public:
+    using MatchId = uint32_t;
+    // Called on the worker after each tick of a match, which it may read
+    using TickObserver = std::function<void(MatchId, Game&, int now_ms)>;
+
+    explicit MatchHost(MatchHostConfig config = {});
+    ~MatchHost();
+    MatchHost(const MatchHost&) = delete;
+    MatchHost& operator=(const MatchHost&) = delete;
+
+    // Set before start()
+    void set_tick_observer(TickObserver observer) { observer_ = std::move(observer); }
+    // Called on the worker right before each tick of a match, with the time
+    // it is about to run at: commands enqueued here are applied by that tick
+    void set_before_tick(TickObserver hook) { before_tick_ = std::move(hook); }
+
+    void start();
+    void stop();
+
+    MatchId open_match();
+    void close_match(MatchId id);
+    // false when no such match is open
+    bool post(MatchId id, Command cmd);
+    // Tick a quiet match on the next host tick (its commands wait outside,
+    // for the before-tick hook)
+    bool wake(MatchId id);
+    // Match time now; -1 when no such match is open
+    int time_ms(MatchId id) const;
+
+    size_t match_count() const;
+
+    struct Stats {
+        uint64_t ticks_run{0};
+        uint64_t ticks_skipped{0};      // quiet matches
+        uint64_t ticks_late{0};         // previous tick still running
+        uint64_t steals{0};
+    };
+    Stats stats() const;
+
+private:
+    struct Match {
+        MatchId id{0};
+        std::unique_ptr<Game> game;
+        std::chrono::steady_clock::time_point opened;
+        std::atomic<bool> busy{false};      // a worker is ticking it
+        std::atomic<bool> quiet{false};     // as of its last tick
+        std::atomic<bool> mail{false};      // commands posted since
+    };
+    using MatchPtr = std::shared_ptr<Match>;
+
+    MatchHostConfig config_;
+    ImgFactoryPtr img_factory_;
+    Board board_;
+    std::shared_ptr<PieceFactory> factory_;
+    TickObserver observer_;
+    TickObserver before_tick_;
+
+    mutable std::mutex matches_mutex_;
+    std::vector<MatchPtr> matches_;         // guarded by matches_mutex_
+    MatchId next_id_{1};                    // guarded by matches_mutex_
+
+    std::unique_ptr<WorkStealingPool> pool_;
+    std::thread host_thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> ticks_run_{0};
+    std::atomic<uint64_t> ticks_skipped_{0};
+    std::atomic<uint64_t> ticks_late_{0};
+
+    MatchPtr find(MatchId id) const;
+    void host_loop();
+    void run_tick(const MatchPtr& match);
+    static int match_time_ms(const Match& match);
+};
@@ -1,6 +1,17 @@
 #include "MoveHistoryManager.hpp"
+#include <cstdio>
 #include <iostream>
 
+namespace {
+std::string cell_text(const std::pair<int,int>& cell) {
+    return std::to_string(cell.first) + "," + std::to_string(cell.second);
+}
+
+bool parse_cell(const std::string& text, std::pair<int,int>& cell) {
+    return std::sscanf(text.c_str(), "%d,%d", &cell.first, &cell.second) == 2;
+}
+}
+
 MoveHistoryManager::MoveHistoryManager() {
     // Initialize empty histories
 }
@@ -15,33 +26,38 @@ void MoveHistoryManager::onEvent(const GameEvent& event) {
         if (it_piece != event.data.end() && it_from != event.data.end() && 
             it_to != event.data.end() && it_timestamp != event.data.end()) {
             
-            int timestamp = std::stoi(it_timestamp->second);
-            add_move_to_history(it_piece->second, it_from->second, it_to->second, timestamp);
+            std::pair<int,int> from, to;
+            if (parse_cell(it_from->second, from) && parse_cell(it_to->second, to)) {
+                int timestamp = std::stoi(it_timestamp->second);
+                add_move_to_history(it_piece->second, from, to, timestamp);
+            }
         }
     }
 }
 
-void MoveHistoryManager::add_move_to_history(const std::string& piece_id, const std::string& from_pos, const std::string& to_pos, int timestamp) {
+void MoveHistoryManager::on(const PieceMoved& event) {
+    add_move_to_history(event.piece_id, event.from, event.to, event.timestamp);
+}
+
+void MoveHistoryManager::add_move_to_history(const std::string& piece_id, std::pair<int,int> from, std::pair<int,int> to, int timestamp) {
+    // Full game log: compact, no strings per move
+    log_.append(piece_id, from, to, timestamp);
+
     MoveRecord move;
     move.piece_id = piece_id;
-    move.from_pos = from_pos;
-    move.to_pos = to_pos;
+    move.from_pos = cell_text(from);
+    move.to_pos = cell_text(to);
     move.timestamp = timestamp;
     
-    // Add to appropriate player's history based on piece color
+    // Add to appropriate player's display ring based on piece color; the
+    // ring drops the oldest move once it holds kRecentMoves
     if (piece_id.length() >= 2) {
         if (piece_id[1] == 'W') {
             white_move_history_.push_back(move);
-            // Keep only last 15 moves for white player
-            if (white_move_history_.size() > 15) {
-                white_move_history_.erase(white_move_history_.begin());
-            }
+            ++white_move_count_;
         } else if (piece_id[1] == 'B') {
             black_move_history_.push_back(move);
-            // Keep only last 15 moves for black player
-            if (black_move_history_.size() > 15) {
-                black_move_history_.erase(black_move_history_.begin());
-            }
+            ++black_move_count_;
         }
     }
-}
\ No newline at end of file
+}
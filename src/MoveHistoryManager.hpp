@@ -1,6 +1,8 @@
 #pragma once
 
-#include "EventSystem.hpp"
+#include "GameEvents.hpp"
+#include "FixedRing.hpp"
+#include "MoveLog.hpp"
 #include <vector>
 #include <string>
 
@@ -14,18 +16,33 @@ struct MoveRecord {
 
 class MoveHistoryManager : public ISubscriber {
 public:
+    // Moves per color kept for the on-screen panel
+    static constexpr size_t kRecentMoves = 15;
+    using RecentMoves = FixedRing<MoveRecord, kRecentMoves>;
+
     MoveHistoryManager();
     
     // ISubscriber interface
     void onEvent(const GameEvent& event) override;
+    // Typed channel (GameEventBus)
+    void on(const PieceMoved& event);
     
-    // Getters
-    const std::vector<MoveRecord>& getWhiteMoves() const { return white_move_history_; }
-    const std::vector<MoveRecord>& getBlackMoves() const { return black_move_history_; }
+    // Getters - last kRecentMoves per color, oldest first
+    const RecentMoves& getWhiteMoves() const { return white_move_history_; }
+    const RecentMoves& getBlackMoves() const { return black_move_history_; }
+    // Moves per color since the start, including those no longer on display
+    size_t getWhiteMoveCount() const { return white_move_count_; }
+    size_t getBlackMoveCount() const { return black_move_count_; }
+
+    // Every move of the game
+    const MoveLog& log() const { return log_; }
     
 private:
-    std::vector<MoveRecord> white_move_history_;
-    std::vector<MoveRecord> black_move_history_;
+    RecentMoves white_move_history_;
+    RecentMoves black_move_history_;
+    size_t white_move_count_ = 0;
+    size_t black_move_count_ = 0;
+    MoveLog log_;
     
-    void add_move_to_history(const std::string& piece_id, const std::string& from_pos, const std::string& to_pos, int timestamp);
-};
\ No newline at end of file
+    void add_move_to_history(const std::string& piece_id, std::pair<int,int> from, std::pair<int,int> to, int timestamp);
+};
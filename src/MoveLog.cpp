@@ -0,0 +1,87 @@
+#include "MoveLog.hpp"
+
+namespace {
+uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+}
+
+void MoveLog::append(const std::string& piece_id, std::pair<int,int> from, std::pair<int,int> to, int timestamp) {
+    put(intern(piece_id));
+    put(zigzag(from.first));
+    put(zigzag(from.second));
+    put(zigzag(to.first));
+    put(zigzag(to.second));
+    put(zigzag(static_cast<int64_t>(timestamp) - last_timestamp));
+    last_timestamp = timestamp;
+    ++count;
+}
+
+void MoveLog::for_each(const std::function<bool(const Entry&)>& visit) const {
+    const uint8_t* p = bytes.data();
+    const uint8_t* end = p + bytes.size();
+    int64_t time = 0;
+    while (p < end) {
+        Entry e;
+        e.piece = static_cast<Handle>(get(p));
+        e.from.first = static_cast<int>(unzigzag(get(p)));
+        e.from.second = static_cast<int>(unzigzag(get(p)));
+        e.to.first = static_cast<int>(unzigzag(get(p)));
+        e.to.second = static_cast<int>(unzigzag(get(p)));
+        time += unzigzag(get(p));
+        e.timestamp = static_cast<int>(time);
+        if (!visit(e)) return;
+    }
+}
+
+std::vector<MoveLog::Entry> MoveLog::entries() const {
+    std::vector<Entry> out;
+    out.reserve(count);
+    for_each([&](const Entry& e) { out.push_back(e); return true; });
+    return out;
+}
+
+std::vector<MoveLog::Entry> MoveLog::entries_for(char color) const {
+    std::vector<Entry> out;
+    for_each([&](const Entry& e) {
+        const auto& id = pieces[e.piece];
+        if (id.size() >= 2 && id[1] == color) out.push_back(e);
+        return true;
+    });
+    return out;
+}
+
+void MoveLog::clear() {
+    bytes.clear();
+    count = 0;
+    last_timestamp = 0;
+    pieces.clear();
+    handles.clear();
+}
+
+MoveLog::Handle MoveLog::intern(const std::string& piece_id) {
+    auto it = handles.find(piece_id);
+    if (it != handles.end()) return it->second;
+    Handle handle = static_cast<Handle>(pieces.size());
+    pieces.push_back(piece_id);
+    handles.emplace(piece_id, handle);
+    return handle;
+}
+
+void MoveLog::put(uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t MoveLog::get(const uint8_t*& p) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= static_cast<uint64_t>(*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(*p++) << shift;
+    return value;
+}
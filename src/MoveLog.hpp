@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Append-only record of every move of a game, compactly encoded. Pieces are
+// interned once and referred to by a small handle. Cells are integers, and
+// each move stores its time as a delta from the previous move. Every field
+// is a LEB128 varint (the time delta zigzag-encoded, since commands may be
+// stamped slightly out of order), so a typical move takes 6-7 bytes and
+// holds no strings.
+// ---------------------------------------------------------------------------
+class MoveLog {
+public:
+    using Handle = uint32_t;
+
+    struct Entry {
+        Handle piece;
+        std::pair<int,int> from;
+        std::pair<int,int> to;
+        int timestamp;          // ms since game start
+    };
+
+    void append(const std::string& piece_id, std::pair<int,int> from, std::pair<int,int> to, int timestamp);
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t encoded_bytes() const { return bytes.size(); }
+
+    // Decode in order; stop early by returning false from the callback
+    void for_each(const std::function<bool(const Entry&)>& visit) const;
+    std::vector<Entry> entries() const;
+
+    // Interned pieces
+    const std::string& piece_id(Handle handle) const { return pieces.at(handle); }
+    size_t piece_count() const { return pieces.size(); }
+    // Moves of one color ('W'/'B'), by the piece id's color letter
+    std::vector<Entry> entries_for(char color) const;
+
+    void clear();
+
+private:
+    std::vector<uint8_t> bytes;
+    size_t count{0};
+    int last_timestamp{0};
+
+    std::vector<std::string> pieces;
+    std::unordered_map<std::string, Handle> handles;
+
+    Handle intern(const std::string& piece_id);
+    void put(uint64_t value);
+    static uint64_t get(const uint8_t*& p);
+};
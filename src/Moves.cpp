@@ -3,6 +3,43 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Cells strictly between src and dst when they share a rank, file or
+// diagonal (0 otherwise). One table per board size, shared by all Moves.
+const std::vector<Bitboard>* between_table(int W, int H) {
+    static std::mutex mtx;
+    static std::map<std::pair<int,int>, std::unique_ptr<std::vector<Bitboard>>> tables;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& table = tables[{W, H}];
+    if (!table) {
+        const int n = W * H;
+        table = std::make_unique<std::vector<Bitboard>>(static_cast<size_t>(n) * n, 0);
+        for (int src = 0; src < n; ++src) {
+            for (int dst = 0; dst < n; ++dst) {
+                int dr = dst / W - src / W;
+                int dc = dst % W - src % W;
+                if (!(dr == 0 || dc == 0 || std::abs(dr) == std::abs(dc))) continue;
+                int steps = std::max(std::abs(dr), std::abs(dc));
+                int sr = (dr > 0) - (dr < 0);
+                int sc = (dc > 0) - (dc < 0);
+                Bitboard mask = 0;
+                for (int i = 1; i < steps; ++i) {
+                    mask |= bitboard::bit((src / W + i * sr) * W + (src % W + i * sc));
+                }
+                (*table)[static_cast<size_t>(src) * n + dst] = mask;
+            }
+        }
+    }
+    return table.get();
+}
+
+} // namespace
 
 // ---------------------------------------------------------------------------
 Moves::Moves(const std::string& txt_path, std::pair<int,int> board_dims)
@@ -22,6 +59,39 @@ Moves::Moves(const std::string& txt_path, std::pair<int,int> board_dims)
         if(line.substr(start,1) == "#") continue; // comment
         rel_moves.push_back(parse_line(line));
     }
+    compile();
+}
+
+// ---------------------------------------------------------------------------
+bool Moves::is_slider(const RelMove& mv) {
+    int adr = std::abs(mv.dr);
+    int adc = std::abs(mv.dc);
+    bool on_line = mv.dr == 0 || mv.dc == 0 || adr == adc;
+    return on_line && std::max(adr, adc) > 1;
+}
+
+void Moves::compile() {
+    if (W <= 0 || H <= 0 || W * H > bitboard::kMaxCells) return;
+
+    between = between_table(W, H);
+    compiled.assign(static_cast<size_t>(W) * H, CompiledRule{});
+    for (int src = 0; src < W * H; ++src) {
+        int r = src / W;
+        int c = src % W;
+        Bitboard seen = 0;
+        auto& rule = compiled[src];
+        for (const auto& mv : rel_moves) {
+            int dr = r + mv.dr;
+            int dc = c + mv.dc;
+            if (dr < 0 || dr >= H || dc < 0 || dc >= W) continue;
+            Bitboard dst = bitboard::bit(dr * W + dc);
+            if (seen & dst) continue; // first listed entry wins, as in is_dst_cell_valid
+            seen |= dst;
+            if (mv.tag != 1) rule.quiet |= dst;
+            if (mv.tag != 0) rule.capture |= dst;
+            if (is_slider(mv)) rule.slider |= dst;
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -77,16 +147,23 @@ bool Moves::is_dst_cell_valid(int dr, int dc, bool dst_has_piece) const {
 bool Moves::is_valid(const std::pair<int,int>& src_cell,
                      const std::pair<int,int>& dst_cell,
                      const std::unordered_set<std::pair<int,int>, PairHash>& cell_with_piece) const {
+    if (is_compiled()) {
+        Bitboard occupied = 0;
+        for (const auto& cell : cell_with_piece) {
+            if (cell.first >= 0 && cell.first < H && cell.second >= 0 && cell.second < W) {
+                occupied |= bitboard::bit(cell.first * W + cell.second);
+            }
+        }
+        return is_valid(src_cell, dst_cell, occupied);
+    }
+
     int dr = dst_cell.first - src_cell.first;
     int dc = dst_cell.second - src_cell.second;
     bool dst_has_piece = cell_with_piece.count(dst_cell) > 0;
     if(!is_dst_cell_valid(dr, dc, dst_has_piece)) return false;
     
-    // Skip path checking for knight moves (L-shape) - knights can jump over pieces
-    bool is_knight_move = (std::abs(dr) == 2 && std::abs(dc) == 1) || 
-                         (std::abs(dr) == 1 && std::abs(dc) == 2);
-    
-    if (!is_knight_move && !path_is_clear(src_cell, dst_cell, cell_with_piece)) {
+    // Leapers (knight, one-step moves) jump over pieces
+    if (is_slider({dr, dc, -1}) && !path_is_clear(src_cell, dst_cell, cell_with_piece)) {
         return false;
     }
     
@@ -95,6 +172,34 @@ bool Moves::is_valid(const std::pair<int,int>& src_cell,
     return true;
 }
 
+bool Moves::is_valid(const std::pair<int,int>& src_cell,
+                     const std::pair<int,int>& dst_cell,
+                     Bitboard occupied) const {
+    if (!is_compiled()) return false;
+    if (src_cell.first < 0 || src_cell.first >= H || src_cell.second < 0 || src_cell.second >= W) return false;
+    if (dst_cell.first < 0 || dst_cell.first >= H || dst_cell.second < 0 || dst_cell.second >= W) return false;
+
+    int src = src_cell.first * W + src_cell.second;
+    int dst = dst_cell.first * W + dst_cell.second;
+    const Bitboard dst_bit = bitboard::bit(dst);
+    const auto& rule = compiled[src];
+
+    Bitboard allowed = (occupied & dst_bit) ? rule.capture : rule.quiet;
+    if (!(allowed & dst_bit)) return false;
+    if ((rule.slider & dst_bit) && (between_mask(src, dst) & occupied)) return false;
+    return true;
+}
+
+bool Moves::is_leap(const std::pair<int,int>& src_cell, const std::pair<int,int>& dst_cell) const {
+    if (!is_compiled()) return false;
+    if (src_cell.first < 0 || src_cell.first >= H || src_cell.second < 0 || src_cell.second >= W) return false;
+    if (dst_cell.first < 0 || dst_cell.first >= H || dst_cell.second < 0 || dst_cell.second >= W) return false;
+
+    const Bitboard dst_bit = bitboard::bit(dst_cell.first * W + dst_cell.second);
+    const auto& rule = compiled[src_cell.first * W + src_cell.second];
+    return ((rule.quiet | rule.capture) & dst_bit) && !(rule.slider & dst_bit);
+}
+
 bool Moves::path_is_clear(const std::pair<int,int>& src_cell,
                           const std::pair<int,int>& dst_cell,
                           const std::unordered_set<std::pair<int,int>, PairHash>& cell_with_piece) const {
@@ -110,4 +215,35 @@ bool Moves::path_is_clear(const std::pair<int,int>& src_cell,
         if(cell_with_piece.count({r,c})) return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+// ---------------------------------------------------------------------------
+Bitboard Moves::generate(const std::pair<int,int>& src_cell, Bitboard occupied, Bitboard own) const {
+    if (!is_compiled()) return 0;
+    if (src_cell.first < 0 || src_cell.first >= H || src_cell.second < 0 || src_cell.second >= W) return 0;
+
+    int src = src_cell.first * W + src_cell.second;
+    const auto& rule = compiled[src];
+    Bitboard targets = (rule.quiet & ~occupied) | (rule.capture & occupied);
+
+    Bitboard slides = targets & rule.slider;
+    while (slides) {
+        int dst = bitboard::pop_lsb(slides);
+        if (between_mask(src, dst) & occupied) {
+            targets &= ~bitboard::bit(dst);
+        }
+    }
+    return targets & ~own;
+}
+
+size_t Moves::generate(const std::pair<int,int>& src_cell, Bitboard occupied, Bitboard own,
+                       std::vector<std::pair<int,int>>& out) const {
+    Bitboard targets = generate(src_cell, occupied, own);
+    size_t added = 0;
+    while (targets) {
+        int dst = bitboard::pop_lsb(targets);
+        out.emplace_back(dst / W, dst % W);
+        ++added;
+    }
+    return added;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include "Bitboard.hpp"
 #include "Common.hpp"
 
 class Moves {
@@ -11,6 +12,15 @@ public:
     // dr,dc,tag where tag: -1 both; 0 non-capture; 1 capture
     struct RelMove { int dr; int dc; int tag; };
 
+    // Per source cell target masks compiled from rel_moves (boards <= 64 cells).
+    // Sliders (multi-step rank/file/diagonal moves) need a clear path; every
+    // other move (knight, one-step) is a leaper and ignores blockers.
+    struct CompiledRule {
+        Bitboard quiet   = 0;   // destinations allowed when empty
+        Bitboard capture = 0;   // destinations allowed when occupied
+        Bitboard slider  = 0;   // destinations that must have a clear path
+    };
+
     Moves(const std::string& txt_path, std::pair<int,int> board_dims);
 
     bool is_dst_cell_valid(int dr, int dc, bool dst_has_piece) const;
@@ -18,13 +28,41 @@ public:
                   const std::pair<int,int>& dst_cell,
                   const std::unordered_set<std::pair<int,int>, PairHash>& cell_with_piece) const;
 
+    // Bitboard validation: a few AND/compare operations on the compiled rule
+    bool is_valid(const std::pair<int,int>& src_cell,
+                  const std::pair<int,int>& dst_cell,
+                  Bitboard occupied) const;
+
+    // Every legal destination from src in one pass: quiet targets on empty
+    // cells, capture targets on occupied ones, blocked slides and cells in
+    // 'own' removed. Requires compiled rules (returns 0 otherwise).
+    Bitboard generate(const std::pair<int,int>& src_cell, Bitboard occupied, Bitboard own = 0) const;
+
+    // Same, appended to a caller-provided buffer; returns the number added
+    size_t generate(const std::pair<int,int>& src_cell, Bitboard occupied, Bitboard own,
+                    std::vector<std::pair<int,int>>& out) const;
+
+    // src -> dst is one of these moves and ignores blockers (a leaper move:
+    // knight jumps, single steps). Requires compiled rules.
+    bool is_leap(const std::pair<int,int>& src_cell, const std::pair<int,int>& dst_cell) const;
+
+    bool is_compiled() const { return !compiled.empty(); }
+    int width() const { return W; }
+    int height() const { return H; }
+
 private:
     std::vector<RelMove> rel_moves;
     int W; int H;
+    std::vector<CompiledRule> compiled;   // indexed by source cell
+    const std::vector<Bitboard>* between = nullptr;
 
     static RelMove parse_line(const std::string& s);
+    static bool is_slider(const RelMove& mv);
+
+    void compile();
+    Bitboard between_mask(int src, int dst) const { return (*between)[src * W * H + dst]; }
 
     bool path_is_clear(const std::pair<int,int>& src_cell,
                        const std::pair<int,int>& dst_cell,
                        const std::unordered_set<std::pair<int,int>, PairHash>& cell_with_piece) const;
-};
\ No newline at end of file
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// Bounded lock-free multi-producer / single-consumer ring (Vyukov's bounded
+// queue). Every slot carries a sequence number: producers claim a position
+// with one CAS and publish by bumping the slot's sequence; the single
+// consumer reads slots in order. No locks and no allocation after
+// construction. N must be a power of two. try_push fails when the ring is
+// full - callers decide whether to drop or retry.
+// ---------------------------------------------------------------------------
+template <typename T, size_t N>
+class MpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two");
+
+public:
+    MpscRing() : cells(new Cell[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // Any thread
+    bool try_push(T value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & (N - 1)];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool try_pop(T& out) {
+        Cell& cell = cells[tail & (N - 1)];
+        size_t seq = cell.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(tail + 1) < 0) {
+            return false; // empty (or the producer has not published yet)
+        }
+        out = std::move(cell.value);
+        cell.seq.store(tail + N, std::memory_order_release);
+        ++tail;
+        return true;
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) size_t tail{0};
+};
@@ -0,0 +1,91 @@
+#include "NetClient.hpp"
+
+#include <stdexcept>
+
+NetClient::NetClient(const std::string& host, uint16_t port, char color)
+    : socket_(Socket::connect_tcp(host, port)) {
+    net::write_join(out_, color);
+    handshake();
+}
+
+NetClient::NetClient(const std::string& host, uint16_t port, Spectate spectate)
+    : socket_(Socket::connect_tcp(host, port)) {
+    net::write_watch(out_, spectate.match_id);
+    handshake();
+}
+
+// Sends the Join/Watch in out_ and waits for the Welcome
+void NetClient::handshake() {
+    socket_.set_nodelay(true);
+    if (!socket_.send_all(out_.data(), out_.size())) {
+        throw std::runtime_error("Server closed the connection");
+    }
+    bytes_sent_ += out_.size();
+    while (match_id_ == 0) {
+        if (!poll(1000)) throw std::runtime_error("Server closed the connection");
+    }
+}
+
+uint32_t NetClient::send(Command cmd) {
+    uint32_t seq = next_seq_++;
+    out_.clear();
+    net::write_command(out_, seq, cmd);
+    if (!socket_.send_all(out_.data(), out_.size())) {
+        throw std::runtime_error("Server closed the connection");
+    }
+    bytes_sent_ += out_.size();
+    return seq;
+}
+
+bool NetClient::poll(int timeout_ms) {
+    std::vector<Socket::PollItem> items{{socket_.handle()}};
+    if (Socket::poll(items, timeout_ms) == 0) return true;
+
+    char buffer[8192];
+    long got = socket_.recv_some(buffer, sizeof(buffer));
+    if (got == 0) return false;
+    if (got == -2) throw std::runtime_error("Connection to the server failed");
+    if (got < 0) return true;
+    bytes_received_ += static_cast<uint64_t>(got);
+    in_.append(buffer, static_cast<size_t>(got));
+
+    net::FrameBuffer::Frame frame;
+    while (in_.next(frame)) {
+        handle(frame);
+    }
+    return true;
+}
+
+void NetClient::handle(const net::FrameBuffer::Frame& frame) {
+    net::Reader in(frame.body, frame.size);
+    switch (frame.type) {
+    case net::Msg::Welcome:
+        match_id_ = static_cast<uint32_t>(in.varint());
+        color_ = static_cast<char>(in.u8());
+        player_id_ = static_cast<int>(in.varint());
+        break;
+    case net::Msg::Reject: {
+        uint32_t seq = static_cast<uint32_t>(in.varint());
+        std::string reason = in.text();
+        if (on_reject) on_reject(seq, reason);
+        break;
+    }
+    case net::Msg::Ids: {
+        uint64_t first = in.varint();
+        if (first != ids_.size()) throw std::runtime_error("Net ids out of order");
+        size_t n = in.count(1);
+        for (size_t i = 0; i < n; ++i) ids_.push_back(in.text());
+        break;
+    }
+    case net::Msg::Tick:
+        net::read_tick(in, tick_);
+        snapshot_.read(in, tick_.time_ms);
+        if (on_tick) on_tick(tick_);
+        break;
+    case net::Msg::GameOver:
+        winner_ = static_cast<char>(in.u8());
+        break;
+    default:
+        throw std::runtime_error("Unexpected message " + std::to_string(static_cast<int>(frame.type)));
+    }
+}
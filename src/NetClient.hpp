@@ -0,0 +1,69 @@
+#pragma once
+
+#include "NetProtocol.hpp"
+#include "SnapshotCodec.hpp"
+#include "Socket.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Client end of the GameServer protocol, for one thread: commands are sent
+// as they are made, and poll() reads whatever the server has sent, keeping
+// the id table and the board rebuilt from keyframes and deltas. Throws std::runtime_error when the
+// connection or the stream breaks.
+// ---------------------------------------------------------------------------
+class NetClient {
+public:
+    // Connects and joins a seat ('W', 'B' or 0 for either); returns once
+    // the server has welcomed it
+    NetClient(const std::string& host, uint16_t port, char color = 0);
+    // Spectator of one match: ticks only, commands are rejected
+    struct Spectate { uint32_t match_id; };
+    NetClient(const std::string& host, uint16_t port, Spectate spectate);
+
+    // Sequence number the Tick that applies it will ack
+    uint32_t send(Command cmd);
+
+    // Waits up to timeout_ms for frames and handles all that arrived;
+    // false once the server has closed the connection
+    bool poll(int timeout_ms);
+
+    std::function<void(const net::TickFrame&)> on_tick;
+    std::function<void(uint32_t seq, const std::string& reason)> on_reject;
+
+    uint32_t match_id() const { return match_id_; }
+    char color() const { return color_; }
+    int player_id() const { return player_id_; }
+    char winner() const { return winner_; }
+
+    // Latest Tick header, and the board as of that tick (handles index
+    // into ids())
+    const net::TickFrame& last_tick() const { return tick_; }
+    const std::vector<net::VisiblePiece>& pieces() const { return snapshot_.pieces(); }
+    const std::vector<std::string>& ids() const { return ids_; }
+
+    uint64_t bytes_sent() const { return bytes_sent_; }
+    uint64_t bytes_received() const { return bytes_received_; }
+
+private:
+    Socket socket_;
+    net::FrameBuffer in_;
+    std::string out_;
+    uint32_t next_seq_{1};
+
+    uint32_t match_id_{0};
+    char color_{0};
+    int player_id_{0};
+    char winner_{0};
+    net::TickFrame tick_;
+    net::SnapshotDecoder snapshot_;
+    std::vector<std::string> ids_;
+
+    uint64_t bytes_sent_{0};
+    uint64_t bytes_received_{0};
+
+    void handshake();
+    void handle(const net::FrameBuffer::Frame& frame);
+};
@@ -0,0 +1,219 @@
+#include "NetProtocol.hpp"
+
+#include <stdexcept>
+
+namespace net {
+
+namespace {
+constexpr size_t kMaxText = 64;
+constexpr size_t kMaxParams = 4;
+}
+
+uint8_t state_code(const std::string& name) {
+    if (name == "idle") return kIdle;
+    if (name == "move") return kMove;
+    if (name == "jump") return kJump;
+    if (name == "long_rest") return kLongRest;
+    if (name == "short_rest") return kShortRest;
+    return kOtherState;
+}
+
+// ---------------------------------------------------------------------------
+void Writer::begin(Msg type) {
+    frame_start = out.size();
+    out.append(2, '\0');            // length, patched by end()
+    u8(static_cast<uint8_t>(type));
+}
+
+void Writer::end() {
+    size_t length = out.size() - frame_start - 2;
+    if (length > kMaxFrame) {
+        out.resize(frame_start);
+        throw std::runtime_error("Net frame too large");
+    }
+    out[frame_start] = static_cast<char>(length & 0xff);
+    out[frame_start + 1] = static_cast<char>(length >> 8);
+}
+
+void Writer::varint(uint64_t value) {
+    while (value >= 0x80) {
+        u8(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    u8(static_cast<uint8_t>(value));
+}
+
+void Writer::fixed64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        u8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void Writer::text(const std::string& value) {
+    varint(value.size());
+    out.append(value);
+}
+
+// ---------------------------------------------------------------------------
+uint8_t Reader::u8() {
+    if (pos >= size) throw std::runtime_error("Net frame truncated");
+    return data[pos++];
+}
+
+uint64_t Reader::varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t b = u8();
+        value |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) return value;
+    }
+    throw std::runtime_error("Net frame: bad varint");
+}
+
+uint64_t Reader::fixed64() {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(u8()) << (8 * i);
+    }
+    return value;
+}
+
+size_t Reader::count(size_t min_bytes) {
+    uint64_t n = varint();
+    if (n > remaining() / min_bytes) throw std::runtime_error("Net frame truncated");
+    return static_cast<size_t>(n);
+}
+
+std::string Reader::text() {
+    uint64_t length = varint();
+    if (length > size - pos) throw std::runtime_error("Net frame truncated");
+    std::string value(reinterpret_cast<const char*>(data + pos), length);
+    pos += length;
+    return value;
+}
+
+// ---------------------------------------------------------------------------
+void FrameBuffer::append(const char* data, size_t size) {
+    // Drop consumed bytes once they are most of the buffer
+    if (pos > 0 && pos * 2 >= bytes.size()) {
+        bytes.erase(bytes.begin(), bytes.begin() + pos);
+        pos = 0;
+    }
+    bytes.insert(bytes.end(), data, data + size);
+}
+
+bool FrameBuffer::next(Frame& frame) {
+    if (buffered() < 2) return false;
+    size_t length = bytes[pos] | (static_cast<size_t>(bytes[pos + 1]) << 8);
+    if (length == 0) throw std::runtime_error("Net frame without a type");
+    if (buffered() < 2 + length) return false;
+    frame.type = static_cast<Msg>(bytes[pos + 2]);
+    frame.body = bytes.data() + pos + 3;
+    frame.size = length - 1;
+    pos += 2 + length;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+void write_join(std::string& out, char color) {
+    Writer w(out);
+    w.begin(Msg::Join);
+    w.u8(static_cast<uint8_t>(color));
+    w.end();
+}
+
+void write_watch(std::string& out, uint32_t match_id) {
+    Writer w(out);
+    w.begin(Msg::Watch);
+    w.varint(match_id);
+    w.end();
+}
+
+void write_command(std::string& out, uint32_t seq, const Command& cmd) {
+    Writer w(out);
+    w.begin(Msg::Command);
+    w.varint(seq);
+    w.text(cmd.piece_id);
+    w.text(cmd.type);
+    w.varint(cmd.params.size());
+    for (const auto& p : cmd.params) {
+        w.zigzag(p.first);
+        w.zigzag(p.second);
+    }
+    w.end();
+}
+
+void write_welcome(std::string& out, uint32_t match_id, char color, int player_id) {
+    Writer w(out);
+    w.begin(Msg::Welcome);
+    w.varint(match_id);
+    w.u8(static_cast<uint8_t>(color));
+    w.varint(static_cast<uint64_t>(player_id));
+    w.end();
+}
+
+void write_reject(std::string& out, uint32_t seq, const std::string& reason) {
+    Writer w(out);
+    w.begin(Msg::Reject);
+    w.varint(seq);
+    w.text(reason);
+    w.end();
+}
+
+void write_ids(std::string& out, uint32_t first, const std::vector<std::string>& ids, size_t begin, size_t end) {
+    Writer w(out);
+    w.begin(Msg::Ids);
+    w.varint(first);
+    w.varint(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        w.text(ids[i]);
+    }
+    w.end();
+}
+
+void write_tick(std::string& out, const TickFrame& tick, const std::string& board) {
+    Writer w(out);
+    w.begin(Msg::Tick);
+    w.varint(tick.tick);
+    w.varint(static_cast<uint64_t>(tick.time_ms));
+    w.fixed64(tick.hash);
+    w.varint(tick.acks.size());
+    for (uint32_t seq : tick.acks) w.varint(seq);
+    out += board;
+    w.end();
+}
+
+void write_game_over(std::string& out, char winner) {
+    Writer w(out);
+    w.begin(Msg::GameOver);
+    w.u8(static_cast<uint8_t>(winner));
+    w.end();
+}
+
+Command read_command(Reader& in, uint32_t& seq) {
+    Command cmd;
+    seq = static_cast<uint32_t>(in.varint());
+    cmd.piece_id = in.text();
+    cmd.type = in.text();
+    if (cmd.piece_id.size() > kMaxText || cmd.type.size() > kMaxText) {
+        throw std::runtime_error("Net command: text too long");
+    }
+    uint64_t n = in.varint();
+    if (n > kMaxParams) throw std::runtime_error("Net command: too many params");
+    for (uint64_t i = 0; i < n; ++i) {
+        int row = static_cast<int>(in.zigzag());
+        int col = static_cast<int>(in.zigzag());
+        cmd.params.emplace_back(row, col);
+    }
+    return cmd;
+}
+
+void read_tick(Reader& in, TickFrame& tick) {
+    tick.tick = in.varint();
+    tick.time_ms = static_cast<int>(in.varint());
+    tick.hash = in.fixed64();
+    tick.acks.resize(in.count(1));
+    for (auto& seq : tick.acks) seq = static_cast<uint32_t>(in.varint());
+}
+
+}  // namespace net
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Command.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Wire format between GameServer and its clients. A frame is a little-endian
+// u16 length (type + body), a u8 message type and the body; integers in a
+// body are LEB128 varints (signed ones zigzag), text is length + bytes.
+//
+// Client -> server
+//   Join      u8 color ('W', 'B', or 0 for either seat)
+//   Watch     match id                     spectator: ticks only
+//   Command   seq, piece id, type, n, n x (row, col)    player id is the seat's
+// Server -> client
+//   Welcome   match id, u8 color ('S' for a spectator), player id
+//   Reject    seq, reason                  command not applied (wrong seat...)
+//   Ids       first, n, n x piece id       appends to the client's id table
+//   Tick      tick, time ms, u64 hash, n, n x seq (commands applied by this
+//             tick), board (keyframe or delta, see SnapshotEncoder)
+//   GameOver  u8 winner
+// Piece ids are sent once per client; boards refer to them by index.
+// ---------------------------------------------------------------------------
+namespace net {
+
+constexpr size_t kMaxFrame = 0xffff;
+
+enum class Msg : uint8_t {
+    Join = 1,
+    Command = 2,
+    Watch = 3,
+    Welcome = 16,
+    Reject = 17,
+    Ids = 18,
+    Tick = 19,
+    GameOver = 20
+};
+
+// Piece state on the wire
+enum PieceState : uint8_t { kIdle, kMove, kJump, kLongRest, kShortRest, kOtherState };
+uint8_t state_code(const std::string& name);
+
+constexpr uint8_t kNoCell = 0xff;
+inline uint8_t cell_code(std::pair<int,int> cell) {
+    bool on_board = cell.first >= 0 && cell.first < 8 && cell.second >= 0 && cell.second < 8;
+    return on_board ? static_cast<uint8_t>(cell.first * 8 + cell.second) : kNoCell;
+}
+
+// Tick header; the board section follows it
+struct TickFrame {
+    uint64_t tick{0};
+    int time_ms{0};
+    uint64_t hash{0};
+    std::vector<uint32_t> acks;
+};
+
+// Appends frames to a byte buffer
+class Writer {
+public:
+    explicit Writer(std::string& out) : out(out) {}
+
+    void begin(Msg type);
+    void end();             // throws std::runtime_error past kMaxFrame
+
+    void u8(uint8_t value) { out.push_back(static_cast<char>(value)); }
+    void varint(uint64_t value);
+    void zigzag(int64_t value) { varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); }
+    void fixed64(uint64_t value);
+    void text(const std::string& value);
+
+private:
+    std::string& out;
+    size_t frame_start{0};
+};
+
+// Reads one frame body; throws std::runtime_error when it runs short
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    bool done() const { return pos >= size; }
+    size_t remaining() const { return size - pos; }
+    // A count of items of at least min_bytes each; throws if it cannot fit
+    size_t count(size_t min_bytes);
+    uint8_t u8();
+    uint64_t varint();
+    int64_t zigzag() { uint64_t v = varint(); return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+    uint64_t fixed64();
+    std::string text();
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos{0};
+};
+
+// Splits a byte stream into frames
+class FrameBuffer {
+public:
+    struct Frame {
+        Msg type;
+        const uint8_t* body;    // valid until the next append()
+        size_t size;
+    };
+
+    void append(const char* data, size_t size);
+    // false when the next frame is not complete yet; throws on a frame
+    // without a type
+    bool next(Frame& frame);
+    size_t buffered() const { return bytes.size() - pos; }
+
+private:
+    std::vector<uint8_t> bytes;
+    size_t pos{0};
+};
+
+// --- messages ---
+void write_join(std::string& out, char color);
+void write_watch(std::string& out, uint32_t match_id);
+void write_command(std::string& out, uint32_t seq, const Command& cmd);
+void write_welcome(std::string& out, uint32_t match_id, char color, int player_id);
+void write_reject(std::string& out, uint32_t seq, const std::string& reason);
+void write_ids(std::string& out, uint32_t first, const std::vector<std::string>& ids, size_t begin, size_t end);
+void write_tick(std::string& out, const TickFrame& tick, const std::string& board);
+void write_game_over(std::string& out, char winner);
+
+// Command bodies come from untrusted peers: at most 4 params, ids and types
+// of at most 64 bytes
+Command read_command(Reader& in, uint32_t& seq);
+// Header only: the board section is next in 'in'
+void read_tick(Reader& in, TickFrame& tick);
+
+}  // namespace net
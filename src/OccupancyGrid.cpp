@@ -0,0 +1,125 @@
+#include "OccupancyGrid.hpp"
+#include "Piece.hpp"
+
+#include <algorithm>
+
+namespace {
+const std::vector<PiecePtr> kNoPieces;
+}
+
+// ---------------------------------------------------------------------------
+OccupancyGrid::OccupancyGrid(int W_cells, int H_cells) {
+    reset(W_cells, H_cells);
+}
+
+void OccupancyGrid::reset(int W_cells, int H_cells) {
+    W = std::max(0, W_cells);
+    H = std::max(0, H_cells);
+    cells.assign(static_cast<size_t>(W) * static_cast<size_t>(H), {});
+    index_of.clear();
+    occupancy = BoardOccupancy{};
+    ++version_;
+}
+
+// ---------------------------------------------------------------------------
+void OccupancyGrid::sync(const std::vector<PiecePtr>& pieces) {
+    ++sync_pass;
+    for (const auto& p : pieces) {
+        if (!p || !p->state || !p->state->physics) continue;
+        int idx = index_for(p->current_cell());
+        auto it = index_of.find(p.get());
+        if (it == index_of.end()) {
+            index_of.emplace(p.get(), Slot{idx, sync_pass});
+            place(p, idx);
+            continue;
+        }
+        it->second.seen = sync_pass;
+        if (it->second.index != idx) {
+            unplace(p.get(), it->second.index);
+            it->second.index = idx;
+            place(p, idx);
+        }
+    }
+
+    // Pieces removed from the game without an explicit remove()
+    if (index_of.size() > pieces.size()) {
+        for (auto it = index_of.begin(); it != index_of.end();) {
+            if (it->second.seen != sync_pass) {
+                unplace(it->first, it->second.index);
+                it = index_of.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void OccupancyGrid::update(const PiecePtr& piece) {
+    if (!piece || !piece->state || !piece->state->physics) return;
+    int idx = index_for(piece->current_cell());
+    auto it = index_of.find(piece.get());
+    if (it == index_of.end()) {
+        index_of.emplace(piece.get(), Slot{idx, sync_pass});
+        place(piece, idx);
+    } else if (it->second.index != idx) {
+        unplace(piece.get(), it->second.index);
+        it->second.index = idx;
+        place(piece, idx);
+    }
+}
+
+void OccupancyGrid::remove(const PiecePtr& piece) {
+    if (!piece) return;
+    auto it = index_of.find(piece.get());
+    if (it == index_of.end()) return;
+    unplace(piece.get(), it->second.index);
+    index_of.erase(it);
+}
+
+// ---------------------------------------------------------------------------
+const std::vector<PiecePtr>& OccupancyGrid::at(const Cell& cell) const {
+    int idx = index_for(cell);
+    return idx < 0 ? kNoPieces : cells[idx];
+}
+
+bool OccupancyGrid::in_bounds(const Cell& cell) const {
+    return cell.first >= 0 && cell.first < H && cell.second >= 0 && cell.second < W;
+}
+
+int OccupancyGrid::index_for(const Cell& cell) const {
+    return in_bounds(cell) ? cell.first * W + cell.second : -1;
+}
+
+void OccupancyGrid::place(const PiecePtr& piece, int index) {
+    if (index < 0) return; // off-board pieces are tracked but not stored
+    cells[index].push_back(piece);
+    refresh_bits(index);
+    ++version_;
+}
+
+void OccupancyGrid::unplace(const Piece* piece, int index) {
+    if (index < 0) return;
+    auto& occupants = cells[index];
+    auto it = std::find_if(occupants.begin(), occupants.end(),
+                           [piece](const PiecePtr& p) { return p.get() == piece; });
+    if (it != occupants.end()) {
+        occupants.erase(it);
+        refresh_bits(index);
+        ++version_;
+    }
+}
+
+// Recompute the three bits of one cell from its occupants
+void OccupancyGrid::refresh_bits(int index) {
+    if (!has_bitboards()) return;
+    const Bitboard mask = bitboard::bit(index);
+    occupancy.all &= ~mask;
+    occupancy.white &= ~mask;
+    occupancy.black &= ~mask;
+    for (const auto& p : cells[index]) {
+        occupancy.all |= mask;
+        char color = p->id.size() >= 2 ? p->id[1] : '?';
+        if (color == 'W') occupancy.white |= mask;
+        else if (color == 'B') occupancy.black |= mask;
+    }
+}
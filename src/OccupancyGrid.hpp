@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Bitboard.hpp"
+#include "Common.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Flat W_cells*H_cells table of the pieces standing on each board cell.
+// Pieces are relocated only when their current_cell() changes, so a frame in
+// which nothing crosses a cell boundary does no work beyond reading cells.
+// version() increases on every change and lets callers cache derived data.
+// ---------------------------------------------------------------------------
+class OccupancyGrid {
+public:
+    using Cell = std::pair<int,int>;
+
+    OccupancyGrid(int W_cells = 0, int H_cells = 0);
+
+    // Drop all occupants and re-dimension the table
+    void reset(int W_cells, int H_cells);
+
+    // Re-read every piece's cell and move only those that changed. Pieces no
+    // longer present in 'pieces' are dropped.
+    void sync(const std::vector<PiecePtr>& pieces);
+
+    // Place/relocate a single piece according to its current cell
+    void update(const PiecePtr& piece);
+    void remove(const PiecePtr& piece);
+
+    // Occupants of a cell (empty for cells outside the board)
+    const std::vector<PiecePtr>& at(const Cell& cell) const;
+    bool in_bounds(const Cell& cell) const;
+    bool empty_at(const Cell& cell) const { return at(cell).empty(); }
+
+    // Bitboard mirror of the table, maintained for boards of <= 64 cells
+    bool has_bitboards() const { return W * H <= bitboard::kMaxCells; }
+    const BoardOccupancy& bitboards() const { return occupancy; }
+    int cell_index(const Cell& cell) const { return index_for(cell); }
+
+    uint64_t version() const { return version_; }
+    int width() const { return W; }
+    int height() const { return H; }
+    size_t piece_count() const { return index_of.size(); }
+
+    // Calls f(cell, occupants) for every non-empty cell in row-major order
+    template <class F>
+    void for_each_occupied(F&& f) const {
+        for (int idx = 0; idx < static_cast<int>(cells.size()); ++idx) {
+            if (!cells[idx].empty()) {
+                f(Cell{idx / W, idx % W}, cells[idx]);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        int index;          // flat cell index, -1 when off-board
+        uint64_t seen;      // sync pass that last saw the piece
+    };
+
+    int W;
+    int H;
+    std::vector<std::vector<PiecePtr>> cells;
+    std::unordered_map<const Piece*, Slot> index_of;
+    BoardOccupancy occupancy;
+    uint64_t version_{0};
+    uint64_t sync_pass{0};
+
+    int index_for(const Cell& cell) const;
+    void place(const PiecePtr& piece, int index);
+    void unplace(const Piece* piece, int index);
+    void refresh_bits(int index);
+};
@@ -3,6 +3,7 @@
 #include "Board.hpp"
 #include "Command.hpp"
 #include "Common.hpp"
+#include "Log.hpp"
 #include <cmath>
 #include <memory>
 #include <iostream>
@@ -36,12 +37,17 @@ public:
 
     int get_start_ms() const { return start_ms; }
 
+    // Game time at which update() will report "done" (-1 = never)
+    virtual int deadline_ms() const { return -1; }
+    // True while the position changes over time and needs per-tick updates
+    virtual bool is_continuous() const { return false; }
+
     virtual bool can_be_captured() const { return true; }
     virtual bool can_capture() const { return true; }
     virtual bool is_movement_blocker() const { return false; }
 
 public:
-    const Board& board;
+    Board board;             // copy: factories may outlive the Board they were given
     double param{1.0};
 
     std::pair<int,int> start_cell{0,0};
@@ -80,7 +86,7 @@ public:
     void reset(const Command& cmd) override {
         if (cmd.params.size() < 2) {
             // Invalid command, stay at current position
-            std::cout << "MOVE: Invalid command - not enough parameters" << std::endl;
+            KFC_WARN(Physics, "MOVE: Invalid command - not enough parameters");
             return;
         }
         
@@ -104,34 +110,45 @@ public:
             duration_s = 0.1; // Minimum duration
         }
         
-        std::cout << "MOVE: (" << start_cell.first << "," << start_cell.second 
-                  << ") -> (" << end_cell.first << "," << end_cell.second << ") duration: " << duration_s << "s" << std::endl;
+        KFC_DEBUG(Physics, "MOVE: (" << start_cell.first << "," << start_cell.second 
+                  << ") -> (" << end_cell.first << "," << end_cell.second << ") duration: " << duration_s << "s");
     }
 
     std::shared_ptr<Command> update(int now_ms) override {
-        // Use safe board values if needed
-        double safe_cell_H_m = (board.cell_H_m < 0.1) ? 1.0 : board.cell_H_m;
-        double safe_cell_W_m = (board.cell_W_m < 0.1) ? 1.0 : board.cell_W_m;
-        
+        curr_pos_m = pos_at(now_ms);
         double seconds = (now_ms - start_ms) / 1000.0;
         if(seconds >= duration_s) {
-            curr_pos_m = {static_cast<double>(end_cell.second), static_cast<double>(end_cell.first)};
-            std::cout << "MOVE completed at: (" << curr_pos_m.first << "," << curr_pos_m.second << ")" << std::endl;
+            KFC_DEBUG(Physics, "MOVE completed at: (" << curr_pos_m.first << "," << curr_pos_m.second << ")");
             return std::make_shared<Command>(Command{now_ms, "", "done", {end_cell}});
         }
+        return nullptr;
+    }
+
+    // Position at a given game time, without changing state. update() and
+    // capture prediction both use this so they always agree on cells.
+    std::pair<double,double> pos_at(int now_ms) const {
+        double seconds = (now_ms - start_ms) / 1000.0;
+        if(seconds >= duration_s) {
+            return {static_cast<double>(end_cell.second), static_cast<double>(end_cell.first)};
+        }
         double ratio = seconds / duration_s;
-        
+        auto start_pos = std::make_pair(static_cast<double>(start_cell.second), static_cast<double>(start_cell.first));
+
         // Safe calculation with bounds checking
         if (ratio >= 0.0 && ratio <= 1.0 && duration_s > 0.0) {
-            auto start_pos = std::make_pair(static_cast<double>(start_cell.second), static_cast<double>(start_cell.first));
-            curr_pos_m = { start_pos.first + movement_vec.first * ratio,
-                           start_pos.second + movement_vec.second * ratio };
-        } else {
-            // Fallback to start position if calculation is invalid
-            curr_pos_m = std::make_pair(static_cast<double>(start_cell.second), static_cast<double>(start_cell.first));
+            return { start_pos.first + movement_vec.first * ratio,
+                     start_pos.second + movement_vec.second * ratio };
         }
-        return nullptr;
+        // Fallback to start position if calculation is invalid
+        return start_pos;
+    }
+
+    std::pair<int,int> cell_at(int now_ms) const { return board.m_to_cell(pos_at(now_ms)); }
+
+    int deadline_ms() const override {
+        return start_ms + static_cast<int>(std::ceil(duration_s * 1000.0));
     }
+    bool is_continuous() const override { return true; }
 
 private:
     std::pair<double,double> movement_vec{0.f,0.f};
@@ -164,6 +181,10 @@ public:
         return nullptr;
     }
 
+    int deadline_ms() const override {
+        return start_ms + static_cast<int>(std::ceil(param * 1000.0));
+    }
+
     bool is_movement_blocker() const override { return true; }
 };
 
@@ -6,6 +6,8 @@
 #include <unordered_map>
 #include <vector>
 #include "Common.hpp"
+#include "OccupancyGrid.hpp"
+#include "PositionHash.hpp"
 #include <iostream>
 
 class Piece;
@@ -13,17 +15,23 @@ typedef std::shared_ptr<Piece> PiecePtr;
 
 class Piece {
 public:
-	Piece(std::string id, std::shared_ptr<State> init_state)
-		: id(id), state(init_state) {}
+	Piece(std::string id, std::shared_ptr<State> init_state, StateGraph graph = {})
+		: id(id), state(init_state), states(std::move(graph)) {}
 
 	std::string id;
 	std::shared_ptr<State> state;
+	// Owns every state 'state' can reach (see State::transitions)
+	StateGraph states;
+
+	// Set by PositionHash::place; transitions keep that hash current
+	PositionHash* position_hash = nullptr;
+	uint64_t hash_key = 0;
 
 	using Cell = std::pair<int, int>;
-	using Cell2Pieces = std::unordered_map<Cell, std::vector<PiecePtr>, PairHash>;
 
-	void on_command(const Command& cmd, Cell2Pieces&) {
+	void on_command(const Command& cmd, const OccupancyGrid&) {
 		state = state->on_command(cmd);
+		if (position_hash) position_hash->update(*this);
 	}
 
 	void reset(int start_ms) {
@@ -33,7 +41,9 @@ public:
 	}
 
 	void update(int now_ms) {
+		auto before = state.get();
 		state = state->update(now_ms);
+		if (position_hash && state.get() != before) position_hash->update(*this);
 	}
 
 	bool is_movement_blocker() const { return state->physics->is_movement_blocker(); }
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "Piece.hpp"
+#include "PieceType.hpp"
 #include "PhysicsFactory.hpp"
 #include "GraphicsFactory.hpp"
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include "nlohmann/json.hpp"
 #include <filesystem>
@@ -20,9 +22,11 @@ namespace fs = std::filesystem;
 #include "Board.hpp"
 #include "Command.hpp"
 
+// Piece types are parsed from disk once and cached as immutable prototypes;
+// creating a piece afterwards only instantiates the prototype's state graph.
 class PieceFactory {
 public:
-    PieceFactory(Board& board,
+    PieceFactory(const Board& board,
                  const std::string& pieces_root,
                  const GraphicsFactory& gfx_factory)
         : board(board), pieces_root(pieces_root), gfx_factory(gfx_factory) {}
@@ -66,8 +70,9 @@ public:
     // Direct translation of PieceFactory.create_piece from Python
     PiecePtr create_piece(const std::string& type_name,
                           const std::pair<int,int>& cell) {
-        fs::path piece_dir = fs::path(pieces_root) / type_name;
-        auto idle_state = build_state_machine(piece_dir);
+        auto type = get_type(type_name);
+        StateGraph graph = type->instantiate(board);
+        auto idle_state = graph.empty() ? nullptr : graph[type->idle_index()];
         if(!idle_state) {
             throw std::runtime_error("Failed to build state machine for piece type: " + type_name);
         }
@@ -75,7 +80,7 @@ public:
         // Mimic Python id format: <type>_(r,c)
         std::string id = type_name + "_(" + std::to_string(cell.first) + "," + std::to_string(cell.second) + ")";
 
-        auto piece = std::make_shared<Piece>(id, idle_state);
+        auto piece = std::make_shared<Piece>(id, idle_state, std::move(graph));
         // FORCE correct position directly in physics
         piece->state->physics->start_cell = cell;
         piece->state->physics->end_cell = cell;
@@ -88,6 +93,30 @@ public:
         return piece;
     }
 
+    // Prototype of a piece type, loaded on first use. Matches on different
+    // threads share one factory, so the cache is locked (a miss loads from
+    // disk while holding it; preload keeps that out of the game loop)
+    PieceTypePtr get_type(const std::string& type_name) {
+        std::lock_guard<std::mutex> lock(types_mutex);
+        auto it = types.find(type_name);
+        if (it != types.end()) return it->second;
+        auto type = build_type(type_name);
+        types.emplace(type_name, type);
+        return type;
+    }
+
+    // Load prototypes ahead of time so later spawns (promotion) never touch disk
+    void preload(const std::vector<std::string>& type_names) {
+        for (const auto& type_name : type_names) {
+            get_type(type_name);
+        }
+    }
+
+    size_t cached_types() const {
+        std::lock_guard<std::mutex> lock(types_mutex);
+        return types.size();
+    }
+
 private:
     // ────────────────────────────────────────────────────────────────────
     using GlobalTrans = std::unordered_map<std::string, std::unordered_map<std::string, std::string>>;
@@ -111,7 +140,8 @@ private:
         return out;
     }
 
-    std::shared_ptr<State> build_state_machine(const fs::path& piece_dir) {
+    PieceTypePtr build_type(const std::string& type_name) {
+        fs::path piece_dir = fs::path(pieces_root) / type_name;
         fs::path states_root = piece_dir / "states";
         if(!fs::exists(states_root) || !fs::is_directory(states_root)) {
             throw std::runtime_error("Missing states directory: " + states_root.string());
@@ -119,10 +149,10 @@ private:
 
         GlobalTrans global_trans = load_master_csv(states_root);
 
-        std::unordered_map<std::string, std::shared_ptr<State>> states;
+        std::vector<StatePrototype> states;
+        std::unordered_map<std::string, size_t> index_of;
 
         std::pair<int,int> board_size = {board.W_cells, board.H_cells};
-        std::pair<int,int> cell_px    = {board.cell_W_pix, board.cell_H_pix};
 
         // iterate over each subdirectory in states_root
         for(const auto& entry : fs::directory_iterator(states_root)) {
@@ -139,50 +169,48 @@ private:
                 }
             }
 
+            StatePrototype proto;
+            proto.name = name;
+
             // Moves
             fs::path moves_path = entry.path() / "moves.txt";
-            std::shared_ptr<Moves> moves_ptr;
             if(fs::exists(moves_path)) {
-                moves_ptr = std::make_shared<Moves>(moves_path.string(), board_size);
+                proto.moves = std::make_shared<Moves>(moves_path.string(), board_size);
             }
 
             // Graphics
             nlohmann::json gfx_cfg = cfg.contains("graphics") ? cfg["graphics"] : nlohmann::json{};
-            auto graphics = gfx_factory.load((entry.path()/"sprites").string(), gfx_cfg, cell_px);
+            proto.frames = gfx_factory.load_frames((entry.path()/"sprites").string());
+            proto.loop = gfx_cfg.value("is_loop", true);
+            proto.fps = gfx_cfg.value("frames_per_sec", 3.0); // Slower default FPS
 
             // Physics
-            nlohmann::json phys_cfg = cfg.contains("physics") ? cfg["physics"] : nlohmann::json{};
-            PhysicsFactory phys_factory(board);
-            auto physics = phys_factory.create({0,0}, name, phys_cfg);
+            proto.physics_cfg = cfg.contains("physics") ? cfg["physics"] : nlohmann::json{};
             // Note: need_clear_path flag not implemented in C++ physics yet
 
-            auto st = std::make_shared<State>(moves_ptr, graphics, physics);
-            st->name = name;
-            states[name] = st;
+            index_of[name] = states.size();
+            states.push_back(std::move(proto));
         }
 
         // apply global transitions overrides
+        std::vector<PieceType::Transition> transitions;
         for(const auto& [frm, ev_map] : global_trans) {
-            auto src_it = states.find(frm);
-            if(src_it == states.end()) continue;
-            auto src = src_it->second;
+            auto src_it = index_of.find(frm);
+            if(src_it == index_of.end()) continue;
             for(const auto& [ev, nxt] : ev_map) {
-                auto dst_it = states.find(nxt);
-                if(dst_it == states.end()) continue;
-                src->set_transition(ev, dst_it->second);
+                auto dst_it = index_of.find(nxt);
+                if(dst_it == index_of.end()) continue;
+                transitions.push_back({src_it->second, ev, dst_it->second});
             }
         }
 
-        // ensure idle exists
-        auto idle_it = states.find("idle");
-        if(idle_it == states.end()) {
-            throw std::runtime_error("State machine missing 'idle' state in " + piece_dir.string());
-        }
-        return idle_it->second;
+        return std::make_shared<const PieceType>(type_name, std::move(states), std::move(transitions));
     }
 
 private:
-    Board& board;
+    Board board;                    // copies: the factory may outlive its creator's locals
     std::string pieces_root;
-    const GraphicsFactory& gfx_factory;
+    GraphicsFactory gfx_factory;
+    mutable std::mutex types_mutex;
+    std::unordered_map<std::string, PieceTypePtr> types;
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "PieceScheduler.hpp"
+#include "Piece.hpp"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+void PieceScheduler::track(const PiecePtr& piece) {
+    if (!piece || !piece->state || !piece->state->physics) return;
+    tracked.insert(piece.get());
+
+    const auto& physics = piece->state->physics;
+    set_moving(piece, physics->is_continuous());
+    int deadline = physics->deadline_ms();
+    if (deadline >= 0) {
+        schedule(piece, deadline);
+    }
+}
+
+void PieceScheduler::untrack(const PiecePtr& piece) {
+    if (!piece) return;
+    tracked.erase(piece.get());
+    set_moving(piece, false);
+    // Heap entries of untracked pieces are dropped when they surface
+}
+
+void PieceScheduler::clear() {
+    deadlines = {};
+    movers.clear();
+    tracked.clear();
+}
+
+// ---------------------------------------------------------------------------
+bool PieceScheduler::advance(int now_ms) {
+    bool changed = false;
+    changed_pieces.clear();
+
+    // Moving pieces: position interpolation (and arrival, if due)
+    scratch.assign(movers.begin(), movers.end());
+    for (const auto& piece : scratch) {
+        changed |= step(piece, now_ms);
+    }
+    scratch.clear();
+
+    // Timed states whose deadline has passed
+    while (!deadlines.empty() && deadlines.top().deadline <= now_ms) {
+        Entry e = deadlines.top();
+        deadlines.pop();
+        if (!is_current(e)) continue;
+        if (step(e.piece, now_ms)) {
+            changed = true;
+        } else {
+            // Physics rounding kept it one tick short; retry on the next tick
+            schedule(e.piece, now_ms + 1);
+        }
+    }
+    return changed;
+}
+
+bool PieceScheduler::step(const PiecePtr& piece, int now_ms) {
+    auto before = piece->state;
+    piece->update(now_ms);
+    if (piece->state == before) return false;
+    track(piece);
+    changed_pieces.push_back(piece);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+void PieceScheduler::schedule(const PiecePtr& piece, int deadline) {
+    deadlines.push(Entry{deadline, next_seq++, piece, piece->state.get(), piece->state->physics->start_ms});
+}
+
+void PieceScheduler::set_moving(const PiecePtr& piece, bool moving) {
+    auto it = std::find(movers.begin(), movers.end(), piece);
+    if (moving && it == movers.end()) {
+        movers.push_back(piece);
+    } else if (!moving && it != movers.end()) {
+        *it = movers.back();
+        movers.pop_back();
+    }
+}
+
+bool PieceScheduler::is_current(const Entry& e) const {
+    return tracked.count(e.piece.get()) &&
+           e.piece->state.get() == e.state &&
+           e.piece->state->physics->start_ms == e.start_ms;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Common.hpp"
+#include <cstdint>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Drives piece state machines without polling every piece each frame.
+// Timed states (move, jump, rests) are kept in a min-heap keyed on their
+// physics deadline (start_ms + duration) and get their "done" transition only
+// once it has passed. Moving pieces are additionally refreshed every tick for
+// interpolation. Idle pieces cost nothing, so per-tick work scales with the
+// number of active pieces.
+// ---------------------------------------------------------------------------
+class PieceScheduler {
+public:
+    // (Re)register a piece after its state may have changed
+    void track(const PiecePtr& piece);
+    void untrack(const PiecePtr& piece);
+    void clear();
+
+    // Refresh moving pieces and fire every deadline <= now_ms.
+    // Returns true if any piece changed state.
+    bool advance(int now_ms);
+    // Pieces that changed state in the last advance(), in order
+    const std::vector<PiecePtr>& changed() const { return changed_pieces; }
+
+    size_t moving_count() const { return movers.size(); }
+    size_t pending_deadlines() const { return deadlines.size(); }
+
+private:
+    struct Entry {
+        int deadline;
+        uint64_t seq;            // FIFO order among equal deadlines
+        PiecePtr piece;
+        const State* state;      // state the deadline belongs to
+        int start_ms;
+    };
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.seq > b.seq;
+        }
+    };
+
+    std::priority_queue<Entry, std::vector<Entry>, Later> deadlines;
+    std::vector<PiecePtr> movers;
+    std::vector<PiecePtr> scratch;
+    std::vector<PiecePtr> changed_pieces;
+    std::unordered_set<const Piece*> tracked;
+    uint64_t next_seq{0};
+
+    void schedule(const PiecePtr& piece, int deadline);
+    void set_moving(const PiecePtr& piece, bool moving);
+    bool is_current(const Entry& e) const;
+    // Update one piece; re-track on a state change. Returns true if it changed.
+    bool step(const PiecePtr& piece, int now_ms);
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "State.hpp"
+#include "PhysicsFactory.hpp"
+#include "Board.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+// ---------------------------------------------------------------------------
+// Immutable description of one piece type (e.g. "PW"), read from disk once:
+// per state the move rules, decoded animation frames, animation settings
+// and physics parameters, plus the transition table. Every piece of the
+// type shares it; instantiate() only allocates the mutable runtime part
+// (state objects with their own timers and position).
+// ---------------------------------------------------------------------------
+struct StatePrototype {
+    std::string name;
+    std::shared_ptr<Moves> moves;           // shared, never modified
+    Graphics::Frames frames;                // shared, never modified
+    bool loop{true};
+    double fps{3.0};
+    nlohmann::json physics_cfg;
+};
+
+class PieceType {
+public:
+    struct Transition {
+        size_t from;
+        std::string event;
+        size_t to;
+    };
+
+    PieceType(std::string name, std::vector<StatePrototype> states, std::vector<Transition> transitions)
+        : name_(std::move(name)), states_(std::move(states)), transitions_(std::move(transitions)) {
+        idle_ = states_.size();
+        for (size_t i = 0; i < states_.size(); ++i) {
+            if (states_[i].name == "idle") idle_ = i;
+        }
+        if (idle_ == states_.size()) {
+            throw std::runtime_error("State machine missing 'idle' state in " + name_);
+        }
+    }
+
+    const std::string& name() const { return name_; }
+    const std::vector<StatePrototype>& states() const { return states_; }
+
+    // Fresh state graph for one piece, in states() order
+    StateGraph instantiate(const Board& board) const {
+        PhysicsFactory phys_factory(board);
+        StateGraph runtime;
+        runtime.reserve(states_.size());
+        for (const auto& proto : states_) {
+            auto graphics = std::make_shared<Graphics>(proto.frames, proto.loop, proto.fps);
+            auto physics = phys_factory.create({0,0}, proto.name, proto.physics_cfg);
+            auto st = std::make_shared<State>(proto.moves, graphics, physics);
+            st->name = proto.name;
+            runtime.push_back(st);
+        }
+        for (const auto& t : transitions_) {
+            runtime[t.from]->set_transition(t.event, runtime[t.to]);
+        }
+        return runtime;
+    }
+    size_t idle_index() const { return idle_; }
+
+private:
+    std::string name_;
+    std::vector<StatePrototype> states_;
+    std::vector<Transition> transitions_;
+    size_t idle_;
+};
+
+using PieceTypePtr = std::shared_ptr<const PieceType>;
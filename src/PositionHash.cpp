@@ -0,0 +1,135 @@
+#include "PositionHash.hpp"
+#include "Piece.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace {
+constexpr int kTypes = 7;       // P N B R Q K, anything else
+constexpr int kColors = 2;
+constexpr int kCells = 64;      // 8x8; larger boards wrap and only collide more
+constexpr int kStates = 6;      // idle move jump long_rest short_rest, other
+
+struct Keys {
+    std::array<uint64_t, kTypes * kColors * kCells * kStates> piece;
+    std::array<uint64_t, kTypes * kColors * kCells * PositionHash::kCooldownBuckets> cooldown;
+
+    Keys() {
+        // Fixed seed: hashes are comparable across runs and processes
+        uint64_t seed = 0x4b4643686573735aull;
+        auto next = [&seed] {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        };
+        for (auto& key : piece) key = next();
+        for (auto& key : cooldown) key = next();
+    }
+};
+
+const Keys& keys() {
+    static const Keys table;
+    return table;
+}
+
+int type_index(const Piece& piece) {
+    static const char kOrder[] = "PNBRQK";
+    const char* found = piece.id.empty() ? nullptr : std::strchr(kOrder, piece.id[0]);
+    return found && *found ? static_cast<int>(found - kOrder) : kTypes - 1;
+}
+
+int state_index(const std::string& name) {
+    if (name == "idle") return 0;
+    if (name == "move") return 1;
+    if (name == "jump") return 2;
+    if (name == "long_rest") return 3;
+    if (name == "short_rest") return 4;
+    return 5;
+}
+
+// type, color, cell
+int square_index(const Piece& piece) {
+    const auto& cell = piece.state->physics->end_cell;
+    int color = piece.id.size() > 1 && piece.id[1] == 'B' ? 1 : 0;
+    int square = (cell.first * 8 + cell.second) & (kCells - 1);
+    return (type_index(piece) * kColors + color) * kCells + square;
+}
+
+bool is_timed(const Piece& piece) {
+    return piece.state && piece.state->physics->deadline_ms() >= 0;
+}
+}
+
+PositionHash::~PositionHash() {
+    // Pieces may outlive the game that hashed them
+    for (Piece* piece : placed) piece->position_hash = nullptr;
+}
+
+uint64_t PositionHash::piece_key(const Piece& piece) {
+    if (!piece.state || !piece.state->physics) return 0;
+    return keys().piece[square_index(piece) * kStates + state_index(piece.state->name)];
+}
+
+uint64_t PositionHash::cooldown_key(const Piece& piece, int now_ms) {
+    if (!is_timed(piece)) return 0;
+    int remaining = std::max(0, piece.state->physics->deadline_ms() - now_ms);
+    int bucket = std::min(remaining / kCooldownBucketMs, kCooldownBuckets - 1);
+    return keys().cooldown[square_index(piece) * kCooldownBuckets + bucket];
+}
+
+// ---------------------------------------------------------------------------
+void PositionHash::place(Piece& piece) {
+    if (piece.position_hash == this) return;
+    placed.push_back(&piece);
+    piece.position_hash = this;
+    piece.hash_key = piece_key(piece);
+    hash ^= piece.hash_key;
+    if (is_timed(piece)) timed.push_back(&piece);
+}
+
+void PositionHash::remove(Piece& piece) {
+    if (piece.position_hash != this) return;
+    hash ^= piece.hash_key;
+    piece.hash_key = 0;
+    piece.position_hash = nullptr;
+    erase(placed, &piece);
+    erase(timed, &piece);
+}
+
+void PositionHash::erase(std::vector<Piece*>& list, Piece* piece) {
+    auto it = std::find(list.begin(), list.end(), piece);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+void PositionHash::update(Piece& piece) {
+    uint64_t key = piece_key(piece);
+    hash ^= piece.hash_key ^ key;
+    piece.hash_key = key;
+
+    bool listed = std::find(timed.begin(), timed.end(), &piece) != timed.end();
+    if (is_timed(piece) && !listed) {
+        timed.push_back(&piece);
+    } else if (!is_timed(piece) && listed) {
+        erase(timed, &piece);
+    }
+}
+
+uint64_t PositionHash::at(int now_ms) const {
+    uint64_t result = hash;
+    for (const Piece* piece : timed) result ^= cooldown_key(*piece, now_ms);
+    return result;
+}
+
+uint64_t PositionHash::compute(const std::vector<std::shared_ptr<Piece>>& pieces, int now_ms) {
+    uint64_t result = 0;
+    for (const auto& piece : pieces) {
+        if (!piece) continue;
+        result ^= piece_key(*piece) ^ cooldown_key(*piece, now_ms);
+    }
+    return result;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Piece;
+
+// ---------------------------------------------------------------------------
+// Zobrist hash of a Kung Fu Chess position: every piece contributes a random
+// 64-bit key for (type, color, cell, state), XORed together. A piece's key is
+// swapped out and in as its state changes (Piece::on_command / update), and
+// removed on capture or promotion, so keeping the hash costs a few XORs per
+// transition instead of a pass over the board per tick.
+//
+// The cell is where the piece will stand: the destination while moving. How
+// much of a timed state is left (move, jump, rests) changes with time rather
+// than with transitions, so at() folds it in as 250 ms buckets from the short
+// list of pieces in such states.
+// ---------------------------------------------------------------------------
+class PositionHash {
+public:
+    static constexpr int kCooldownBucketMs = 250;
+    static constexpr int kCooldownBuckets = 16;     // last bucket: 3.75 s or more
+
+    PositionHash() = default;
+    PositionHash(const PositionHash&) = delete;
+    PositionHash& operator=(const PositionHash&) = delete;
+    ~PositionHash();
+
+    // Start/stop following a piece; it reports its transitions itself
+    void place(Piece& piece);
+    void remove(Piece& piece);
+    // Called by the piece after a state change
+    void update(Piece& piece);
+
+    // Types, colors, cells and states
+    uint64_t value() const { return hash; }
+    // ... plus remaining time of every timed state
+    uint64_t at(int now_ms) const;
+
+    // From scratch, for verifying the incremental value
+    static uint64_t compute(const std::vector<std::shared_ptr<Piece>>& pieces, int now_ms);
+
+    static uint64_t piece_key(const Piece& piece);
+    static uint64_t cooldown_key(const Piece& piece, int now_ms);
+
+private:
+    uint64_t hash{0};
+    std::vector<Piece*> placed;
+    std::vector<Piece*> timed;      // pieces whose state has a deadline
+
+    static void erase(std::vector<Piece*>& list, Piece* piece);
+};
@@ -0,0 +1,26 @@
+#include "Replay.hpp"
+#include "Game.hpp"
+
+#include <chrono>
+
+ReplayResult replay(Game& game, const CommandLog& log) {
+    ReplayResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    log.for_each_tick([&](const CommandLog::Tick& tick) {
+        // Queued commands are due (timestamp <= tick time), so this tick
+        // applies exactly these, in recorded order
+        for (const auto& cmd : tick.commands) {
+            game.enqueue_command(cmd);
+        }
+        game.step_to(tick.time_ms);
+        ++result.ticks;
+        result.commands += tick.commands.size();
+    });
+
+    result.end_ms = log.finished() ? log.end_ms() : log.last_tick_ms();
+    result.checksum = game.position_hash().at(result.end_ms);
+    result.checksum_ok = log.finished() && result.checksum == log.checksum();
+    result.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CommandLog.hpp"
+#include <cstdint>
+
+class Game;
+
+struct ReplayResult {
+    size_t ticks = 0;
+    size_t commands = 0;
+    int end_ms = 0;
+    uint64_t checksum = 0;      // board after the last tick
+    bool checksum_ok = false;   // matches the recording's (false if unfinished)
+    double wall_ms = 0;
+};
+
+// Run a recorded game headless, as fast as the simulation goes: every
+// recorded tick is replayed at its original time with the commands it
+// applied. 'game' must be freshly created from the same board and pieces.
+ReplayResult replay(Game& game, const CommandLog& log);
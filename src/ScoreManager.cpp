@@ -16,6 +16,12 @@ void ScoreManager::onEvent(const GameEvent& event) {
     }
 }
 
+void ScoreManager::on(const PieceCaptured& event) {
+    if (event.captured.length() >= 2) {
+        update_score(event.captured[1], event.captured[0]);
+    }
+}
+
 int ScoreManager::get_piece_value(char piece_type) {
     switch (piece_type) {
         case 'P': return 1;  // Pawn
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "EventSystem.hpp"
+#include "GameEvents.hpp"
 #include <unordered_map>
 #include <string>
 
@@ -15,15 +15,19 @@ public:
     
     // ISubscriber interface
     void onEvent(const GameEvent& event) override;
+    // Typed channel (GameEventBus)
+    void on(const PieceCaptured& event);
     
     // Getters
     const PlayerScore& getWhiteScore() const { return white_score_; }
     const PlayerScore& getBlackScore() const { return black_score_; }
+
+    // Material value of a piece type ('P', 'N', ...); the king is 0
+    static int get_piece_value(char piece_type);
     
 private:
     PlayerScore white_score_;
     PlayerScore black_score_;
     
-    int get_piece_value(char piece_type);
     void update_score(char captured_color, char piece_type);
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "SelfPlay.hpp"
+#include "Game.hpp"
+#include "ThreadPool.hpp"
+#include "img/MockImg.hpp"
+
+#include <chrono>
+#include <mutex>
+
+SelfPlayReport run_self_play(const SelfPlayConfig& config) {
+    SelfPlayReport report;
+    std::mutex report_mutex;
+    auto img_factory = std::make_shared<MockImgFactory>();
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        ThreadPool pool(config.threads);
+        for (int i = 0; i < config.games; ++i) {
+            pool.submit([&] {
+                auto game = create_game(config.pieces_root, img_factory, false);
+                BotConfig white = config.white, black = config.black;
+                white.inline_search = black.inline_search = true;
+                game.add_bot('W', white);
+                game.add_bot('B', black);
+                game.run_simulation(config.max_game_ms / config.step_ms, config.step_ms);
+
+                char winner = game.winner();
+                std::lock_guard<std::mutex> lock(report_mutex);
+                ++report.games;
+                if (winner == 'W') ++report.white_wins;
+                else if (winner == 'B') ++report.black_wins;
+                else ++report.draws;
+                report.white_captures += game.score('W').captured_pieces;
+                report.black_captures += game.score('B').captured_pieces;
+                report.game_ms += game.game_time_ms();
+            });
+        }
+        pool.wait_idle();
+    }
+
+    report.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
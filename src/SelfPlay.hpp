@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Bot.hpp"
+#include <string>
+
+struct SelfPlayConfig {
+    std::string pieces_root = "pieces/";
+    int games = 16;
+    size_t threads = 0;             // 0: one per hardware thread
+    int step_ms = 16;               // simulation tick
+    int max_game_ms = 300000;       // no king captured by then: draw
+    BotConfig white;
+    BotConfig black;
+};
+
+struct SelfPlayReport {
+    int games = 0;
+    int white_wins = 0;
+    int black_wins = 0;
+    int draws = 0;
+    int white_captures = 0;         // totals over all games
+    int black_captures = 0;
+    double game_ms = 0;             // simulated time, all games
+    double wall_s = 0;
+
+    double games_per_s() const { return wall_s > 0 ? games / wall_s : 0; }
+    double game_seconds_per_s() const { return wall_s > 0 ? game_ms / 1000.0 / wall_s : 0; }
+    double avg_captures(char color) const {
+        return games ? static_cast<double>(color == 'W' ? white_captures : black_captures) / games : 0;
+    }
+};
+
+// Bot against bot, 'games' headless games on a thread pool. Every game is
+// independent (own pieces, clock, bots); sprites are not decoded and no
+// sound is loaded. Bots search inline on their game's thread.
+SelfPlayReport run_self_play(const SelfPlayConfig& config);
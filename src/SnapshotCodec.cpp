@@ -0,0 +1,162 @@
+#include "SnapshotCodec.hpp"
+#include "Piece.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace net {
+
+namespace {
+enum Kind : uint8_t { kKeyframe = 0, kDelta = 1 };
+enum Flags : uint8_t { kStateMask = 0x07, kMoving = 0x08, kTimed = 0x10, kHasFrame = 0x20 };
+
+// Handles go in increasing order as gaps: consecutive ones cost a zero byte
+void put_piece(Writer& w, const VisiblePiece& p, uint32_t& next_handle, int time_ms) {
+    w.varint(p.handle - next_handle);
+    next_handle = p.handle + 1;
+    uint8_t flags = p.state & kStateMask;
+    if (p.from != p.to) flags |= kMoving;
+    if (p.duration_ms > 0) flags |= kTimed;
+    if (p.frame != 0) flags |= kHasFrame;
+    w.u8(flags);
+    w.u8(p.to);
+    if (flags & kMoving) w.u8(p.from);
+    w.zigzag(static_cast<int64_t>(time_ms) - p.start_ms);
+    if (flags & kTimed) w.varint(static_cast<uint64_t>(p.duration_ms));
+    if (flags & kHasFrame) w.varint(p.frame);
+}
+
+VisiblePiece get_piece(Reader& in, uint32_t& next_handle, int time_ms) {
+    VisiblePiece p;
+    uint64_t handle = next_handle + in.varint();
+    if (handle > UINT32_MAX) throw std::runtime_error("Net snapshot: bad handle");
+    p.handle = static_cast<uint32_t>(handle);
+    next_handle = p.handle + 1;
+    uint8_t flags = in.u8();
+    p.state = flags & kStateMask;
+    p.to = in.u8();
+    p.from = (flags & kMoving) ? in.u8() : p.to;
+    p.start_ms = static_cast<int>(time_ms - in.zigzag());
+    p.duration_ms = (flags & kTimed) ? static_cast<int>(in.varint()) : 0;
+    p.frame = (flags & kHasFrame) ? static_cast<uint32_t>(in.varint()) : 0;
+    return p;
+}
+
+bool by_handle(const VisiblePiece& a, const VisiblePiece& b) { return a.handle < b.handle; }
+}
+
+VisiblePiece visible_piece(const Piece& piece, uint32_t handle) {
+    const auto& physics = *piece.state->physics;
+    VisiblePiece p;
+    p.handle = handle;
+    p.state = state_code(piece.state->name);
+    p.to = cell_code(physics.end_cell);
+    p.from = p.state == kMove ? cell_code(physics.start_cell) : p.to;
+    p.start_ms = physics.start_ms;
+    int deadline = physics.deadline_ms();
+    p.duration_ms = deadline >= 0 ? std::max(0, deadline - physics.start_ms) : 0;
+    p.frame = static_cast<uint32_t>(piece.state->graphics->current_frame());
+    return p;
+}
+
+std::pair<double,double> interpolated_cell(const VisiblePiece& piece, int now_ms) {
+    auto to = std::make_pair(static_cast<double>(piece.to / 8), static_cast<double>(piece.to % 8));
+    if (piece.from == piece.to || piece.duration_ms <= 0) return to;
+    double t = static_cast<double>(now_ms - piece.start_ms) / piece.duration_ms;
+    t = std::min(1.0, std::max(0.0, t));
+    auto from = std::make_pair(static_cast<double>(piece.from / 8), static_cast<double>(piece.from % 8));
+    return {from.first + (to.first - from.first) * t, from.second + (to.second - from.second) * t};
+}
+
+// ---------------------------------------------------------------------------
+void SnapshotEncoder::set(std::vector<VisiblePiece> board, int time_ms) {
+    delta_.clear();
+    keyframe_valid_ = false;
+    changed_ = 0;
+
+    // Both boards are in handle order: one merge pass
+    std::vector<uint32_t> removed;
+    std::string changes;
+    Writer cw(changes);
+    uint32_t next_handle = 0;
+    size_t i = 0, j = 0;
+    while (i < board_.size() || j < board.size()) {
+        if (j == board.size() || (i < board_.size() && board_[i].handle < board[j].handle)) {
+            removed.push_back(board_[i++].handle);
+        } else if (i == board_.size() || board[j].handle < board_[i].handle) {
+            put_piece(cw, board[j++], next_handle, time_ms);
+            ++changed_;
+        } else {
+            if (!board[j].same_state(board_[i])) {
+                put_piece(cw, board[j], next_handle, time_ms);
+                ++changed_;
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    Writer w(delta_);
+    w.u8(kDelta);
+    w.varint(changed_);
+    delta_ += changes;
+    w.varint(removed.size());
+    next_handle = 0;
+    for (uint32_t handle : removed) {
+        w.varint(handle - next_handle);
+        next_handle = handle + 1;
+    }
+
+    board_ = std::move(board);
+    time_ms_ = time_ms;
+}
+
+const std::string& SnapshotEncoder::keyframe() {
+    if (keyframe_valid_) return keyframe_;
+    keyframe_.clear();
+    Writer w(keyframe_);
+    w.u8(kKeyframe);
+    w.varint(board_.size());
+    uint32_t next_handle = 0;
+    for (const auto& p : board_) {
+        put_piece(w, p, next_handle, time_ms_);
+    }
+    keyframe_valid_ = true;
+    return keyframe_;
+}
+
+// ---------------------------------------------------------------------------
+void SnapshotDecoder::read(Reader& in, int time_ms) {
+    uint8_t kind = in.u8();
+    if (kind != kKeyframe && kind != kDelta) throw std::runtime_error("Net snapshot: bad kind");
+    if (kind == kDelta && !has_keyframe_) throw std::runtime_error("Net snapshot: delta before keyframe");
+
+    size_t n = in.count(4);
+    changes_.clear();
+    uint32_t next_handle = 0;
+    for (size_t i = 0; i < n; ++i) {
+        changes_.push_back(get_piece(in, next_handle, time_ms));
+    }
+    if (kind == kKeyframe) {
+        board_.swap(changes_);
+        has_keyframe_ = true;
+        return;
+    }
+
+    for (const auto& p : changes_) {
+        auto it = std::lower_bound(board_.begin(), board_.end(), p, by_handle);
+        if (it != board_.end() && it->handle == p.handle) *it = p;
+        else board_.insert(it, p);
+    }
+    size_t removed = in.count(1);
+    next_handle = 0;
+    for (size_t i = 0; i < removed; ++i) {
+        VisiblePiece key;
+        key.handle = static_cast<uint32_t>(next_handle + in.varint());
+        next_handle = key.handle + 1;
+        auto it = std::lower_bound(board_.begin(), board_.end(), key, by_handle);
+        if (it != board_.end() && it->handle == key.handle) board_.erase(it);
+    }
+}
+
+}  // namespace net
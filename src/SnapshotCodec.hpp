@@ -0,0 +1,87 @@
+#pragma once
+
+#include "NetProtocol.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Piece;
+
+namespace net {
+
+// What a remote viewer needs to draw one piece. Moves are sent as their
+// interpolation inputs (from, to, start, duration, as MovePhysics keeps
+// them), so clients animate without a position per frame.
+struct VisiblePiece {
+    uint32_t handle{0};         // index into the id table
+    uint8_t state{kIdle};
+    uint8_t from{kNoCell};      // row * 8 + col
+    uint8_t to{kNoCell};        // == from unless moving
+    int start_ms{0};            // state entered
+    int duration_ms{0};         // until the state's deadline; 0: none
+    uint32_t frame{0};          // animation frame when sent
+
+    // Changes that go into a delta; the animation frame alone does not
+    bool same_state(const VisiblePiece& o) const {
+        return state == o.state && from == o.from && to == o.to &&
+               start_ms == o.start_ms && duration_ms == o.duration_ms;
+    }
+};
+
+VisiblePiece visible_piece(const Piece& piece, uint32_t handle);
+
+// Position in cells (row, col) at now_ms: on the way from 'from' to 'to'
+// while moving, else on 'to'
+std::pair<double,double> interpolated_cell(const VisiblePiece& piece, int now_ms);
+
+// ---------------------------------------------------------------------------
+// Board section of a Tick frame:
+//   u8 kind       0 keyframe: n, n x piece (every piece)
+//                 1 delta:    n, n x piece (new or changed since the last
+//                             tick), m, m x handle (gone)
+//   piece         handle (gap from the previous one, in handle order),
+//                 u8 flags (state | 0x08 moving | 0x10 timed | 0x20 frame),
+//                 u8 to, [u8 from], age ms (zigzag, tick time - start),
+//                 [duration ms], [frame]
+// A piece that changes costs 4-7 bytes, so a typical delta is a few bytes
+// and a full 32-piece keyframe about 150.
+// ---------------------------------------------------------------------------
+class SnapshotEncoder {
+public:
+    // This tick's board, in handle order. delta() then holds the changes
+    // since the previous set()
+    void set(std::vector<VisiblePiece> board, int time_ms);
+
+    const std::string& delta() const { return delta_; }
+    // Encoded on first use in a tick
+    const std::string& keyframe();
+
+    size_t changed() const { return changed_; }
+
+private:
+    std::vector<VisiblePiece> board_;
+    int time_ms_{0};
+    std::string delta_;
+    std::string keyframe_;
+    bool keyframe_valid_{false};
+    size_t changed_{0};
+};
+
+// Client side: rebuilds the board from a keyframe and the deltas after it
+class SnapshotDecoder {
+public:
+    // Throws std::runtime_error on a delta before any keyframe
+    void read(Reader& in, int time_ms);
+
+    bool has_keyframe() const { return has_keyframe_; }
+    // In handle order
+    const std::vector<VisiblePiece>& pieces() const { return board_; }
+
+private:
+    std::vector<VisiblePiece> board_;
+    std::vector<VisiblePiece> changes_;
+    bool has_keyframe_{false};
+};
+
+}  // namespace net
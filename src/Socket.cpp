@@ -0,0 +1,202 @@
+#include "Socket.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+namespace {
+using native_handle = SOCKET;
+struct WinsockInit {
+    WinsockInit() {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    }
+    ~WinsockInit() { WSACleanup(); }
+};
+void ensure_winsock() { static WinsockInit init; }
+bool would_block() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+}
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+namespace {
+using native_handle = int;
+void ensure_winsock() {}
+bool would_block() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+}
+#endif
+
+namespace {
+native_handle native(socket_handle handle) { return static_cast<native_handle>(handle); }
+socket_handle wrap(native_handle handle) { return static_cast<socket_handle>(handle); }
+
+sockaddr_in make_address(const std::string& host, uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) {
+        throw std::runtime_error("Bad IPv4 address: " + host);
+    }
+    return addr;
+}
+}
+
+socket_handle Socket::invalid_handle() {
+#ifdef _WIN32
+    return wrap(INVALID_SOCKET);
+#else
+    return -1;
+#endif
+}
+
+bool Socket::valid() const { return handle_ != invalid_handle(); }
+
+socket_handle Socket::release() {
+    socket_handle handle = handle_;
+    handle_ = invalid_handle();
+    return handle;
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle_ = other.release();
+    }
+    return *this;
+}
+
+void Socket::close() {
+    if (!valid()) return;
+#ifdef _WIN32
+    ::closesocket(native(handle_));
+#else
+    ::close(native(handle_));
+#endif
+    handle_ = invalid_handle();
+}
+
+// ---------------------------------------------------------------------------
+Socket Socket::listen_tcp(const std::string& host, uint16_t port, int backlog) {
+    ensure_winsock();
+    Socket sock(wrap(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)));
+    if (!sock.valid()) throw std::runtime_error("socket() failed");
+    int reuse = 1;
+    ::setsockopt(native(sock.handle_), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in addr = make_address(host, port);
+    if (::bind(native(sock.handle_), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw std::runtime_error("Cannot bind " + host + ":" + std::to_string(port));
+    }
+    if (::listen(native(sock.handle_), backlog) != 0) {
+        throw std::runtime_error("listen() failed");
+    }
+    return sock;
+}
+
+Socket Socket::connect_tcp(const std::string& host, uint16_t port) {
+    ensure_winsock();
+    Socket sock(wrap(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP)));
+    if (!sock.valid()) throw std::runtime_error("socket() failed");
+    sockaddr_in addr = make_address(host, port);
+    if (::connect(native(sock.handle_), reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port));
+    }
+    return sock;
+}
+
+Socket Socket::accept() const {
+    return Socket(wrap(::accept(native(handle_), nullptr, nullptr)));
+}
+
+long Socket::send_some(const void* data, size_t size) const {
+#ifdef _WIN32
+    int sent = ::send(native(handle_), static_cast<const char*>(data), static_cast<int>(size), 0);
+#else
+    ssize_t sent = ::send(native(handle_), data, size, MSG_NOSIGNAL);
+#endif
+    if (sent >= 0) return static_cast<long>(sent);
+    return would_block() ? 0 : -1;
+}
+
+bool Socket::send_all(const void* data, size_t size) const {
+    auto bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        long sent = send_some(bytes, size);
+        if (sent < 0) return false;
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+long Socket::recv_some(void* data, size_t size) const {
+#ifdef _WIN32
+    int got = ::recv(native(handle_), static_cast<char*>(data), static_cast<int>(size), 0);
+#else
+    ssize_t got = ::recv(native(handle_), data, size, 0);
+#endif
+    if (got >= 0) return static_cast<long>(got);
+    return would_block() ? -1 : -2;
+}
+
+int Socket::poll(std::vector<PollItem>& items, int timeout_ms) {
+    std::vector<pollfd> fds(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        fds[i].fd = native(items[i].handle);
+        fds[i].events = static_cast<short>(POLLIN | (items[i].want_write ? POLLOUT : 0));
+        fds[i].revents = 0;
+    }
+#ifdef _WIN32
+    int ready = ::WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout_ms);
+#else
+    int ready = ::poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout_ms);
+#endif
+    if (ready < 0) {
+#ifndef _WIN32
+        if (errno == EINTR) return 0;
+#endif
+        throw std::runtime_error("poll() failed");
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i].readable = (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+        items[i].writable = (fds[i].revents & POLLOUT) != 0;
+    }
+    return ready;
+}
+
+void Socket::set_nonblocking(bool on) const {
+#ifdef _WIN32
+    u_long mode = on ? 1 : 0;
+    ::ioctlsocket(native(handle_), FIONBIO, &mode);
+#else
+    int flags = ::fcntl(native(handle_), F_GETFL, 0);
+    ::fcntl(native(handle_), F_SETFL, on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+#endif
+}
+
+void Socket::set_nodelay(bool on) const {
+    int flag = on ? 1 : 0;
+    ::setsockopt(native(handle_), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&flag), sizeof(flag));
+}
+
+uint16_t Socket::local_port() const {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(native(handle_), reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+        throw std::runtime_error("getsockname() failed");
+    }
+    return ntohs(addr.sin_port);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Winsock stays inside Socket.cpp: <winsock2.h> brings in <windows.h>
+// and its min/max macros
+#ifdef _WIN32
+using socket_handle = std::uintptr_t;   // SOCKET
+#else
+using socket_handle = int;
+#endif
+
+// ---------------------------------------------------------------------------
+// Owning TCP socket (Winsock or POSIX). Setup failures throw
+// std::runtime_error; send/recv report would-block and closed connections
+// through their return values so the server loop can keep going.
+// ---------------------------------------------------------------------------
+class Socket {
+public:
+    Socket() = default;
+    explicit Socket(socket_handle handle) : handle_(handle) {}
+    ~Socket() { close(); }
+    Socket(Socket&& other) noexcept : handle_(other.release()) {}
+    Socket& operator=(Socket&& other) noexcept;
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    // port 0: any free port (see local_port)
+    static Socket listen_tcp(const std::string& host, uint16_t port, int backlog = 64);
+    static Socket connect_tcp(const std::string& host, uint16_t port);
+
+    // Invalid socket when nothing is waiting (non-blocking listener)
+    Socket accept() const;
+
+    // Bytes sent, 0 if it would block, -1 when the connection is gone
+    long send_some(const void* data, size_t size) const;
+    // Blocking socket: everything or false
+    bool send_all(const void* data, size_t size) const;
+    // Bytes read, 0 when the peer closed, -1 if it would block, -2 on error
+    long recv_some(void* data, size_t size) const;
+
+    // Readiness of several sockets at once (poll / WSAPoll)
+    struct PollItem {
+        socket_handle handle;
+        bool want_write{false};
+        bool readable{false};       // data, a connection or a hangup waiting
+        bool writable{false};
+    };
+    // Number of ready items; 0 on timeout
+    static int poll(std::vector<PollItem>& items, int timeout_ms);
+
+    void set_nonblocking(bool on) const;
+    void set_nodelay(bool on) const;    // small frames go out right away
+    uint16_t local_port() const;
+
+    bool valid() const;
+    socket_handle handle() const { return handle_; }
+    void close();
+
+private:
+    socket_handle handle_ = invalid_handle();
+
+    static socket_handle invalid_handle();
+    socket_handle release();
+};
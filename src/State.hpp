@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <cctype>
 
 class State : public std::enable_shared_from_this<State> {
@@ -19,8 +20,10 @@ public:
     std::shared_ptr<Graphics> graphics;
     std::shared_ptr<BasePhysics> physics;
 
-    // Keep strong references so target states are not destroyed while only reachable via this map
-    std::unordered_map<std::string, std::shared_ptr<State>> transitions;
+    // Non-owning: the states of a piece point at each other in cycles
+    // (idle -> move -> long_rest -> idle), so the piece owns them all
+    // (StateGraph) and they are freed with it
+    std::unordered_map<std::string, std::weak_ptr<State>> transitions;
     std::string name;
 
     void set_transition(const std::string& event, const std::shared_ptr<State>& target) { transitions[event] = target; }
@@ -35,7 +38,7 @@ public:
         for(auto& ch : key) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
         auto it = transitions.find(key);
         if(it != transitions.end()) {
-            auto next = it->second;
+            auto next = it->second.lock();
             if(next) {
                 next->reset(cmd);
                 return next;
@@ -55,4 +58,7 @@ public:
 
     bool can_be_captured() const { return physics->can_be_captured(); }
     bool can_capture()    const { return physics->can_capture(); }
-};
\ No newline at end of file
+};
+
+// Every state of one piece; owner of the graph the transitions link
+using StateGraph = std::vector<std::shared_ptr<State>>;
\ No newline at end of file
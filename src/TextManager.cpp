@@ -1,9 +1,10 @@
 #include "TextManager.hpp"
+#include "Log.hpp"
 #include <iostream>
 
 TextManager::TextManager() {
     current_text_ = "GAME START";
-    std::cout << "📝 TextManager initialized with: " << current_text_ << std::endl;
+    KFC_DEBUG(Events, "📝 TextManager initialized with: " << current_text_);
 }
 
 void TextManager::onEvent(const GameEvent& event) {
@@ -22,20 +23,20 @@ void TextManager::onEvent(const GameEvent& event) {
 
 void TextManager::setGameStartText() {
     current_text_ = "GAME START";
-    std::cout << "📝 Text updated to: " << current_text_ << std::endl;
+    KFC_DEBUG(Events, "📝 Text updated to: " << current_text_);
 }
 
 void TextManager::setGamePlayingText() {
     current_text_ = "";
-    std::cout << "📝 Text cleared for playing state" << std::endl;
+    KFC_DEBUG(Events, "📝 Text cleared for playing state");
 }
 
 void TextManager::setGameEndedText() {
     current_text_ = "GAME ENDED";
-    std::cout << "📝 Text updated to: " << current_text_ << std::endl;
+    KFC_DEBUG(Events, "📝 Text updated to: " << current_text_);
 }
 
 void TextManager::setWinnerText(const std::string& winner) {
     current_text_ = winner + " WINS!";
-    std::cout << "📝 Text updated to: " << current_text_ << std::endl;
+    KFC_DEBUG(Events, "📝 Text updated to: " << current_text_);
 }
\ No newline at end of file
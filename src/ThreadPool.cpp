@@ -0,0 +1,62 @@
+#include "ThreadPool.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    work_cv.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle_cv.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        work_cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty()) {
+            return; // stopping and drained
+        }
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+        ++running;
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception& e) {
+            KFC_ERROR(General, "Thread pool task failed: " << e.what());
+        }
+        lock.lock();
+        --running;
+        if (tasks.empty() && running == 0) {
+            idle_cv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Fixed set of worker threads running queued tasks in submission order.
+// wait_idle() blocks until every submitted task has finished; the destructor
+// finishes the queue and joins the workers. A task that throws is dropped
+// and its exception logged, so one bad task does not take a worker down.
+// ---------------------------------------------------------------------------
+class ThreadPool {
+public:
+    // threads == 0: one per hardware thread
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait_idle();
+
+    size_t size() const { return workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::deque<std::function<void()>> tasks;    // guarded by mutex
+    size_t running{0};                          // guarded by mutex
+    bool stopping{false};                       // guarded by mutex
+
+    void worker_loop();
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// ---------------------------------------------------------------------------
+// Single-writer / single-reader triple buffer. The writer fills back() and
+// publish()es it; the reader fetch()es the most recent published value into
+// front(). Neither side ever waits for the other: the writer always has a
+// free slot and the reader always has a complete one. Values nobody read
+// are overwritten. Slots are reused, so a T holding vectors keeps its
+// capacity and steady-state publishing does not allocate.
+// ---------------------------------------------------------------------------
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer thread
+    T& back() { return slots[back_index]; }
+    void publish() {
+        back_index = middle.exchange(back_index | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // Reader thread. Returns true when front() now holds a newer value.
+    bool fetch() {
+        if (!(middle.load(std::memory_order_acquire) & kFresh)) return false;
+        front_index = middle.exchange(front_index, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+    const T& front() const { return slots[front_index]; }
+
+private:
+    static constexpr unsigned kIndexMask = 3;
+    static constexpr unsigned kFresh = 4;     // middle holds an unread value
+
+    std::array<T, 3> slots{};
+    alignas(64) std::atomic<unsigned> middle{1};
+    alignas(64) unsigned back_index{0};
+    alignas(64) unsigned front_index{2};
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Thread pool with one task deque per worker. Outside threads deal tasks
+// round-robin; a task submitted from a worker goes to that worker's own
+// deque. Workers take their newest task first (warm cache) and, when out
+// of work, steal the oldest task of another worker, so a few long tasks do
+// not leave the other cores idle. Each deque has its own lock, so workers
+// only contend when stealing.
+// ---------------------------------------------------------------------------
+class WorkStealingPool {
+public:
+    // threads == 0: one per hardware thread
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+    // Until every submitted task has finished
+    void wait_idle();
+
+    size_t size() const { return workers.size(); }
+    uint64_t steals() const { return steal_count.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> next_queue{0};
+    std::atomic<size_t> queued{0};          // in some deque
+    std::atomic<size_t> unfinished{0};      // queued or running
+    std::atomic<uint64_t> steal_count{0};
+
+    std::mutex sleep_mutex;
+    std::condition_variable sleep_cv;
+    std::condition_variable idle_cv;
+    bool stopping{false};                   // guarded by sleep_mutex
+
+    bool try_pop(size_t self, std::function<void()>& task);
+    void worker_loop(size_t self);
+};
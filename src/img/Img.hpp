@@ -20,6 +20,11 @@ public:
     virtual void put_text(const std::string& /*txt*/, int /*x*/, int /*y*/, double /*font_size*/) {}
     virtual void show() const {}
     virtual ImgPtr clone() const = 0;
+    // Overwrite dst with this image, reusing dst's buffer when sizes match
+    virtual void copy_to(Img& /*dst*/) const {}
+    // Copy the w x h block at (x,y) to (dst_x,dst_y) in dst, clipped to both images
+    virtual void copy_region_to(Img& /*dst*/, int /*x*/, int /*y*/, int /*w*/, int /*h*/,
+                                int /*dst_x*/, int /*dst_y*/) const {}
 
     virtual void draw_rect(int x, int y, int width, int height, const std::vector<uint8_t> & color) = 0;
 };
\ No newline at end of file
@@ -20,6 +20,45 @@ ImgPtr OpenCvImg::clone() const
 	return res;
 }
 
+void OpenCvImg::copy_to(Img& dst) const
+{
+	auto* cvDst = dynamic_cast<OpenCvImg*>(&dst);
+	if (!cvDst) return;
+	// copyTo only reallocates when size or type differ
+	impl->mat.copyTo(cvDst->impl->mat);
+}
+
+void OpenCvImg::copy_region_to(Img& dst, int x, int y, int w, int h, int dst_x, int dst_y) const
+{
+	auto* cvDst = dynamic_cast<OpenCvImg*>(&dst);
+	if (!cvDst) return;
+	if (impl->mat.empty() || cvDst->impl->mat.empty()) return;
+
+	// Clip against the source, then against the destination
+	cv::Rect src_rect = cv::Rect(x, y, w, h) & cv::Rect(0, 0, impl->mat.cols, impl->mat.rows);
+	if (src_rect.empty()) return;
+	cv::Rect dst_rect(dst_x + (src_rect.x - x), dst_y + (src_rect.y - y), src_rect.width, src_rect.height);
+	cv::Rect dst_clip = dst_rect & cv::Rect(0, 0, cvDst->impl->mat.cols, cvDst->impl->mat.rows);
+	if (dst_clip.empty()) return;
+	src_rect = cv::Rect(src_rect.x + (dst_clip.x - dst_rect.x), src_rect.y + (dst_clip.y - dst_rect.y),
+	                    dst_clip.width, dst_clip.height);
+
+	cv::Mat src_roi = impl->mat(src_rect);
+	if (src_roi.channels() != cvDst->impl->mat.channels()) {
+		cv::Mat converted;
+		if (src_roi.channels() == 4 && cvDst->impl->mat.channels() == 3) {
+			cv::cvtColor(src_roi, converted, cv::COLOR_BGRA2BGR);
+		} else if (src_roi.channels() == 3 && cvDst->impl->mat.channels() == 4) {
+			cv::cvtColor(src_roi, converted, cv::COLOR_BGR2BGRA);
+		} else {
+			return;
+		}
+		converted.copyTo(cvDst->impl->mat(dst_clip));
+		return;
+	}
+	src_roi.copyTo(cvDst->impl->mat(dst_clip));
+}
+
 void OpenCvImg::read(const std::string& path, const std::pair<int, int>& size) {
 	impl->mat = cv::imread(path, cv::IMREAD_UNCHANGED);
 	if (impl->mat.empty()) throw std::runtime_error("Cannot load image: " + path);
@@ -19,6 +19,8 @@ public:
     void put_text(const std::string& txt, int x, int y, double font_size) override;
     void show() const override;
     ImgPtr clone() const override;
+    void copy_to(Img& dst) const override;
+    void copy_region_to(Img& dst, int x, int y, int w, int h, int dst_x, int dst_y) const override;
 
     void create_blank(int width, int height);
 
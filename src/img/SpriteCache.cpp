@@ -0,0 +1,63 @@
+#include "SpriteCache.hpp"
+
+#include <typeinfo>
+
+SpriteCache& SpriteCache::instance() {
+    static SpriteCache cache;
+    return cache;
+}
+
+std::string SpriteCache::key_for(const ImgFactory& factory, const std::string& path,
+                                 const std::pair<int,int>& size) {
+    // Loader type is part of the key: a mock image must never satisfy an OpenCV load
+    return std::string(typeid(factory).name()) + '|' + path + '|' +
+           std::to_string(size.first) + 'x' + std::to_string(size.second);
+}
+
+ImgPtr SpriteCache::get(ImgFactory& factory, const std::string& path, const std::pair<int,int>& size) {
+    const std::string key = key_for(factory, path, size);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = images.find(key);
+        if (it != images.end()) {
+            ++hit_count;
+            return it->second;
+        }
+    }
+
+    // Decode outside the lock; if two threads race, the first insert wins
+    ImgPtr img = factory.load(path, size);
+    if (!img) return img;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++miss_count;
+    return images.emplace(key, img).first->second;
+}
+
+size_t SpriteCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return images.size();
+}
+
+size_t SpriteCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hit_count;
+}
+
+size_t SpriteCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return miss_count;
+}
+
+void SpriteCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    images.clear();
+    hit_count = 0;
+    miss_count = 0;
+}
+
+// ---------------------------------------------------------------------------
+ImgFactoryPtr CachingImgFactory::wrap(const ImgFactoryPtr& factory) {
+    if (!factory || std::dynamic_pointer_cast<CachingImgFactory>(factory)) return factory;
+    return std::make_shared<CachingImgFactory>(factory);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ImgFactory.hpp"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// ---------------------------------------------------------------------------
+// Process-wide cache of decoded sprites keyed by (loader, path, size).
+// Every pawn, in every state, shares the same frames instead of decoding
+// its own copy. Cached images are shared by reference, so callers must
+// treat them as read-only (draw them onto something else, never into them).
+// ---------------------------------------------------------------------------
+class SpriteCache {
+public:
+    static SpriteCache& instance();
+
+    // Returns the cached image, decoding it through 'factory' on a miss
+    ImgPtr get(ImgFactory& factory, const std::string& path, const std::pair<int,int>& size);
+
+    size_t size() const;
+    size_t hits() const;
+    size_t misses() const;
+    void clear();
+
+private:
+    SpriteCache() = default;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, ImgPtr> images;
+    size_t hit_count{0};
+    size_t miss_count{0};
+
+    static std::string key_for(const ImgFactory& factory, const std::string& path,
+                               const std::pair<int,int>& size);
+};
+
+// ImgFactory decorator that serves load() from the SpriteCache.
+// create_blank() is never cached - blank images are meant to be drawn into.
+class CachingImgFactory : public ImgFactory {
+public:
+    explicit CachingImgFactory(ImgFactoryPtr inner) : inner(std::move(inner)) {}
+
+    ImgPtr load(const std::string& path, const std::pair<int,int>& size = {0,0}) override {
+        return SpriteCache::instance().get(*inner, path, size);
+    }
+
+    ImgPtr create_blank(int width, int height) const override {
+        return inner->create_blank(width, height);
+    }
+
+    // Wraps 'factory' unless it already caches
+    static ImgFactoryPtr wrap(const ImgFactoryPtr& factory);
+
+private:
+    ImgFactoryPtr inner;
+};
@@ -16,7 +16,7 @@ int main() {
     } catch (const std::exception& e) {
         std::cerr << "❌ Error: " << e.what() << std::endl;
         std::cout << "Press Enter to continue..." << std::endl;
-        std::cin.get();
+        Game::wait_for_enter();
         return 1;
     }
     return 0;
@@ -0,0 +1,37 @@
+#include <iostream>
+#include "Game.hpp"
+#include "Replay.hpp"
+#include "img/MockImg.hpp"
+#include <memory>
+
+// kungfu_chess_replay <recording> [pieces_root]
+// Replays a game recorded with KFC_RECORD and checks the final board;
+// headless, with no images or sound
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <recording> [pieces_root]" << std::endl;
+        return 2;
+    }
+    try {
+        auto log = CommandLog::load(argv[1]);
+        auto img_factory = std::make_shared<MockImgFactory>();
+        std::string pieces_root = argc > 2 ? argv[2] : "pieces/";
+        auto game = create_game(pieces_root, img_factory, false);
+
+        ReplayResult result = replay(game, log);
+        std::cout << "Replayed " << result.ticks << " ticks, " << result.commands << " commands, "
+                  << result.end_ms << " ms of game in " << result.wall_ms << " ms" << std::endl;
+        if (!log.finished()) {
+            std::cout << "Recording has no end record; checksum not verified" << std::endl;
+            return 1;
+        }
+        std::cout << "Checksum " << std::hex << result.checksum
+                  << (result.checksum_ok ? " matches" : " DIFFERS from recorded ") ;
+        if (!result.checksum_ok) std::cout << log.checksum();
+        std::cout << std::dec << std::endl;
+        return result.checksum_ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,43 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Log.hpp"
+#include "SelfPlay.hpp"
+
+// kungfu_chess_selfplay [--games N] [--threads N] [--budget MS] [--max-seconds S] [--pieces DIR]
+int main(int argc, char** argv) {
+    SelfPlayConfig config;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* flag = argv[i];
+        const char* value = argv[i + 1];
+        if (!std::strcmp(flag, "--games")) config.games = std::atoi(value);
+        else if (!std::strcmp(flag, "--threads")) config.threads = static_cast<size_t>(std::atoi(value));
+        else if (!std::strcmp(flag, "--budget")) config.white.budget_ms = config.black.budget_ms = std::atoi(value);
+        else if (!std::strcmp(flag, "--max-seconds")) config.max_game_ms = std::atoi(value) * 1000;
+        else if (!std::strcmp(flag, "--pieces")) config.pieces_root = value;
+        else {
+            std::cerr << "unknown option " << flag << std::endl;
+            return 2;
+        }
+    }
+    // Per-move chatter from many games at once is noise here
+    if (!std::getenv("KFC_LOG_LEVEL")) {
+        Logger::instance().set_level(LogLevel::Warn);
+    }
+
+    try {
+        SelfPlayReport r = run_self_play(config);
+        std::printf("games          %d in %.2f s\n", r.games, r.wall_s);
+        std::printf("games/s        %.2f\n", r.games_per_s());
+        std::printf("game-s/s       %.1f\n", r.game_seconds_per_s());
+        std::printf("white wins     %.1f%%\n", r.games ? 100.0 * r.white_wins / r.games : 0.0);
+        std::printf("black wins     %.1f%%\n", r.games ? 100.0 * r.black_wins / r.games : 0.0);
+        std::printf("draws          %.1f%%\n", r.games ? 100.0 * r.draws / r.games : 0.0);
+        std::printf("captures/game  white %.2f  black %.2f\n", r.avg_captures('W'), r.avg_captures('B'));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
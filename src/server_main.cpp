@@ -0,0 +1,83 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "GameServer.hpp"
+#include "Log.hpp"
+#include "Loopback.hpp"
+
+// kungfu_chess_server [--host IP] [--port N] [--threads N] [--tick MS] [--pieces DIR]
+//                     [--loopback MATCHES] [--seconds S] [--interval MS] [--spectators N]
+// Serves until Enter is pressed; with --loopback it plays scripted clients
+// against itself on localhost and prints latency and throughput.
+int main(int argc, char** argv) {
+    LoopbackConfig config;
+    GameServerConfig& server = config.server;
+    bool loopback = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* flag = argv[i];
+        const char* value = argv[i + 1];
+        if (!std::strcmp(flag, "--host")) server.host = value;
+        else if (!std::strcmp(flag, "--port")) server.port = static_cast<uint16_t>(std::atoi(value));
+        else if (!std::strcmp(flag, "--threads")) server.matches.threads = static_cast<size_t>(std::atoi(value));
+        else if (!std::strcmp(flag, "--tick")) server.matches.tick_ms = std::atoi(value);
+        else if (!std::strcmp(flag, "--pieces")) server.matches.pieces_root = value;
+        else if (!std::strcmp(flag, "--loopback")) { loopback = true; config.matches = std::atoi(value); }
+        else if (!std::strcmp(flag, "--seconds")) config.seconds = std::atoi(value);
+        else if (!std::strcmp(flag, "--interval")) config.command_interval_ms = std::atoi(value);
+        else if (!std::strcmp(flag, "--spectators")) config.spectators = std::atoi(value);
+        else {
+            std::cerr << "unknown option " << flag << std::endl;
+            return 2;
+        }
+    }
+    // Per-move chatter from many matches at once is noise here
+    if (!std::getenv("KFC_LOG_LEVEL")) {
+        Logger::instance().set_level(LogLevel::Warn);
+    }
+
+    try {
+        if (loopback) {
+            LoopbackReport r = run_loopback(config);
+            std::printf("clients        %d (%d matches) for %.2f s\n", r.clients, config.matches, r.wall_s);
+            std::printf("commands       %llu sent, %llu applied, %llu rejected\n",
+                        static_cast<unsigned long long>(r.commands_sent),
+                        static_cast<unsigned long long>(r.commands_acked),
+                        static_cast<unsigned long long>(r.rejected));
+            std::printf("commands/s     %.1f\n", r.commands_per_s());
+            std::printf("ticks/s        %.1f (all clients)\n", r.ticks_per_s());
+            std::printf("tick frames    %llu, %.1f bytes avg, %llu keyframes\n",
+                        static_cast<unsigned long long>(r.tick_frames), r.bytes_per_tick(),
+                        static_cast<unsigned long long>(r.keyframes));
+            if (r.spectators) {
+                std::printf("spectators     %d, %llu ticks, %llu bytes\n", r.spectators,
+                            static_cast<unsigned long long>(r.spectator_ticks),
+                            static_cast<unsigned long long>(r.bytes_to_spectators));
+            }
+            std::printf("latency ms     p50 %.2f  p99 %.2f  max %.2f\n",
+                        r.latency_p50_ms, r.latency_p99_ms, r.latency_max_ms);
+            std::printf("bytes          %llu to server, %llu to clients (%.1f KB/s per client)\n",
+                        static_cast<unsigned long long>(r.bytes_to_server),
+                        static_cast<unsigned long long>(r.bytes_to_clients),
+                        r.clients && r.wall_s > 0 ? r.bytes_to_clients / 1024.0 / r.clients / r.wall_s : 0.0);
+            return 0;
+        }
+
+        GameServer game_server(server);
+        game_server.start();
+        std::printf("listening on %s:%u, press Enter to stop\n", server.host.c_str(), game_server.port());
+        std::string line;
+        std::getline(std::cin, line);
+        GameServer::Stats s = game_server.stats();
+        game_server.stop();
+        std::printf("commands %llu, rejected %llu, ticks sent %llu, bytes in %llu out %llu\n",
+                    static_cast<unsigned long long>(s.commands), static_cast<unsigned long long>(s.rejected),
+                    static_cast<unsigned long long>(s.ticks_sent), static_cast<unsigned long long>(s.bytes_in),
+                    static_cast<unsigned long long>(s.bytes_out));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "doctest.h"
+
+#include "CommandLog.hpp"
+#include "Game.hpp"
+#include "Replay.hpp"
+#include "img/MockImg.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace {
+
+bool same_command(const Command& a, const Command& b) {
+    return a.timestamp == b.timestamp && a.piece_id == b.piece_id && a.type == b.type &&
+           a.params == b.params && a.player_id == b.player_id;
+}
+
+std::vector<CommandLog::Tick> decode(const CommandLog& log) {
+    std::vector<CommandLog::Tick> ticks;
+    log.for_each_tick([&](const CommandLog::Tick& tick) { ticks.push_back(tick); });
+    return ticks;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("CommandLog round-trips ticks, runs and commands") {
+    // Empty ticks at changing rates around ticks that carry commands
+    std::vector<CommandLog::Tick> ticks;
+    int t = 0;
+    for (int i = 0; i < 10; ++i) ticks.push_back({t += 16, {}});
+    ticks.push_back({t += 16, {Command(t - 3, "PW_(6,4)", "move", {{6, 4}, {4, 4}}, 1),
+                               Command(t - 1, "", "white_up", {}, 1)}});
+    for (int i = 0; i < 5; ++i) ticks.push_back({t += 7, {}});
+    ticks.push_back({t += 40, {}});
+    ticks.push_back({t += 16, {Command(t, "PB_(1,3)", "jump", {{1, 3}}, 2)}});
+
+    CommandLog log;
+    for (const auto& tick : ticks) {
+        log.begin_tick(tick.time_ms);
+        for (const auto& cmd : tick.commands) log.add(cmd);
+    }
+    log.finish(ticks.back().time_ms, 0x1234abcdULL);
+
+    CHECK(log.tick_count() == ticks.size());
+    CHECK(log.command_count() == 3);
+
+    auto path = (std::filesystem::temp_directory_path() / "kfc_test_command_log.kfcr").string();
+    log.save(path);
+    CommandLog loaded = CommandLog::load(path);
+    std::filesystem::remove(path);
+
+    for (const CommandLog* l : {&log, &loaded}) {
+        auto decoded = decode(*l);
+        REQUIRE(decoded.size() == ticks.size());
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            CHECK(decoded[i].time_ms == ticks[i].time_ms);
+            REQUIRE(decoded[i].commands.size() == ticks[i].commands.size());
+            for (size_t j = 0; j < ticks[i].commands.size(); ++j) {
+                CHECK(same_command(decoded[i].commands[j], ticks[i].commands[j]));
+            }
+        }
+        CHECK(l->finished());
+        CHECK(l->end_ms() == ticks.back().time_ms);
+        CHECK(l->last_tick_ms() == ticks.back().time_ms);
+        CHECK(l->checksum() == 0x1234abcdULL);
+    }
+}
+
+TEST_CASE("CommandLog rejects commands outside a tick and writes after finish") {
+    CommandLog log;
+    CHECK_THROWS(log.add(Command(0, "PW_(6,4)", "move", {{6, 4}, {4, 4}})));
+    log.begin_tick(16);
+    log.finish(16, 0);
+    CHECK_THROWS(log.begin_tick(32));
+}
+
+// ---------------------------------------------------------------------------
+TEST_CASE("A recorded game replays to the same checksum") {
+    auto img_factory = std::make_shared<MockImgFactory>();
+    auto log = std::make_shared<CommandLog>();
+    uint64_t recorded = 0;
+    {
+        Game game = create_game("pieces/", img_factory, false);
+        game.set_recording(log);
+        game.enqueue_command(Command(100, "PW_(6,4)", "move", {{6, 4}, {4, 4}}));
+        game.enqueue_command(Command(103, "PB_(1,3)", "move", {{1, 3}, {3, 3}}));
+        game.enqueue_command(Command(5000, "PW_(6,4)", "move", {{4, 4}, {3, 3}}));
+        game.enqueue_command(Command(5000, "", "white_up", {}, 1));
+        game.run_simulation(300, 16);
+        game.run_simulation(200, 7);
+        game.finish_recording();
+        recorded = game.position_hash().at(log->end_ms());
+    }
+    REQUIRE(log->finished());
+    CHECK(log->command_count() == 4);
+    CHECK(log->checksum() == recorded);
+    CHECK(log->end_ms() == log->last_tick_ms());
+
+    Game fresh = create_game("pieces/", img_factory, false);
+    ReplayResult result = replay(fresh, *log);
+    CHECK(result.ticks == log->tick_count());
+    CHECK(result.commands == log->command_count());
+    CHECK(result.checksum == recorded);
+    CHECK(result.checksum_ok);
+}
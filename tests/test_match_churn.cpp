@@ -0,0 +1,85 @@
+#include "doctest.h"
+
+#include "Game.hpp"
+#include "MatchHost.hpp"
+#include "img/MockImg.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Every state of every piece, without keeping any alive
+std::vector<std::weak_ptr<State>> watch_states(const Game& game) {
+    std::vector<std::weak_ptr<State>> states;
+    for (const auto& piece : game.pieces) {
+        for (const auto& state : piece->states) states.push_back(state);
+    }
+    return states;
+}
+
+size_t alive(const std::vector<std::weak_ptr<State>>& states) {
+    size_t n = 0;
+    for (const auto& state : states) n += !state.expired();
+    return n;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("A game frees its pieces' state graphs") {
+    std::vector<std::weak_ptr<State>> states;
+    {
+        Game game = create_game("pieces/", std::make_shared<MockImgFactory>(), false);
+        game.enqueue_command(Command(16, "PW_(6,4)", "move", {{6, 4}, {4, 4}}, 1));
+        for (int t = 16; t <= 2000; t += 16) game.step_to(t);
+        states = watch_states(game);
+        REQUIRE(states.size() > game.pieces.size());
+    }
+    CHECK(alive(states) == 0);
+}
+
+TEST_CASE("Closed matches leave nothing behind") {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<State>> states;
+    std::unordered_set<MatchHost::MatchId> seen;
+    std::atomic<size_t> ticked{0};      // matches seen
+
+    MatchHostConfig config;
+    config.threads = 2;
+    MatchHost host(config);
+    host.set_tick_observer([&](MatchHost::MatchId id, Game& game, int) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!seen.insert(id).second) return;
+        auto watched = watch_states(game);
+        states.insert(states.end(), watched.begin(), watched.end());
+        ticked.fetch_add(1);
+    });
+    host.start();
+
+    for (int round = 0; round < 20; ++round) {
+        std::vector<MatchHost::MatchId> ids;
+        for (int i = 0; i < 10; ++i) {
+            ids.push_back(host.open_match());
+            // New matches are quiet; a move gets them ticked
+            host.post(ids.back(), Command(0, "PW_(6,4)", "move", {{6, 4}, {4, 4}}, 1));
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (ticked.load() < static_cast<size_t>(round + 1) * ids.size() &&
+               std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (auto id : ids) host.close_match(id);
+    }
+    host.stop();
+
+    CHECK(host.match_count() == 0);
+    std::lock_guard<std::mutex> lock(mutex);
+    CHECK_FALSE(states.empty());
+    CHECK(alive(states) == 0);
+}
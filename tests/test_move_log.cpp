@@ -0,0 +1,77 @@
+#include "doctest.h"
+
+#include "FixedRing.hpp"
+#include "MoveLog.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename Ring>
+std::vector<int> contents(const Ring& ring) {
+    return std::vector<int>(ring.begin(), ring.end());
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("FixedRing keeps the newest N, oldest first") {
+    FixedRing<int, 4> ring;
+    CHECK(ring.empty());
+
+    for (int i = 1; i <= 3; ++i) ring.push_back(i);
+    CHECK(contents(ring) == std::vector<int>{1, 2, 3});
+
+    // Wrap around more than once
+    for (int i = 4; i <= 11; ++i) ring.push_back(i);
+    CHECK(ring.size() == 4);
+    CHECK(contents(ring) == std::vector<int>{8, 9, 10, 11});
+    CHECK(ring[0] == 8);
+    CHECK(ring.back() == 11);
+
+    ring.clear();
+    CHECK(ring.empty());
+    ring.push_back(42);
+    CHECK(contents(ring) == std::vector<int>{42});
+}
+
+// ---------------------------------------------------------------------------
+TEST_CASE("MoveLog round-trips moves, including out-of-order timestamps") {
+    struct Move { std::string id; std::pair<int,int> from, to; int t; };
+    std::vector<Move> moves = {
+        {"PW_(6,4)", {6, 4}, {4, 4}, 100},
+        {"PB_(1,3)", {1, 3}, {3, 3}, 95},       // stamped before the previous one
+        {"NW_(7,6)", {7, 6}, {5, 5}, 2000},
+        {"PW_(6,4)", {4, 4}, {3, 3}, 70000},
+        {"QB_(0,3)", {0, 3}, {7, 3}, 69990},
+    };
+
+    MoveLog log;
+    for (const auto& m : moves) log.append(m.id, m.from, m.to, m.t);
+
+    CHECK(log.size() == moves.size());
+    CHECK(log.piece_count() == 4);          // PW_(6,4) is interned once
+
+    auto entries = log.entries();
+    REQUIRE(entries.size() == moves.size());
+    for (size_t i = 0; i < moves.size(); ++i) {
+        CHECK(log.piece_id(entries[i].piece) == moves[i].id);
+        CHECK(entries[i].from == moves[i].from);
+        CHECK(entries[i].to == moves[i].to);
+        CHECK(entries[i].timestamp == moves[i].t);
+    }
+
+    auto black = log.entries_for('B');
+    REQUIRE(black.size() == 2);
+    CHECK(log.piece_id(black[1].piece) == "QB_(0,3)");
+
+    // for_each stops when the callback returns false
+    size_t visited = 0;
+    log.for_each([&](const MoveLog::Entry&) { return ++visited < 2; });
+    CHECK(visited == 2);
+
+    log.clear();
+    CHECK(log.empty());
+    CHECK(log.entries().empty());
+}
@@ -0,0 +1,96 @@
+#include "doctest.h"
+
+#include "Moves.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+Moves load_moves(const std::string& type, const std::string& state = "idle") {
+    return Moves("pieces/" + type + "/states/" + state + "/moves.txt", {8, 8});
+}
+
+std::pair<int,int> cell_of(int index) { return {index / 8, index % 8}; }
+
+// Random boards with roughly a third of the cells occupied
+Bitboard random_board(std::mt19937_64& rng) {
+    return rng() & rng();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("Moves::generate agrees with is_valid for every piece type") {
+    const char* types[] = {"PW", "PB", "NW", "BW", "RW", "QW", "KW"};
+    std::mt19937_64 rng(2024);
+
+    for (const char* type : types) {
+        Moves moves = load_moves(type);
+        REQUIRE(moves.is_compiled());
+
+        for (int round = 0; round < 50; ++round) {
+            Bitboard occupied = random_board(rng);
+            Bitboard own = occupied & rng();
+            for (int src = 0; src < 64; ++src) {
+                Bitboard targets = moves.generate(cell_of(src), occupied, own);
+
+                Bitboard expected = 0;
+                for (int dst = 0; dst < 64; ++dst) {
+                    if (bitboard::test(own, dst)) continue;
+                    if (moves.is_valid(cell_of(src), cell_of(dst), occupied)) expected |= bitboard::bit(dst);
+                }
+                CHECK(targets == expected);
+
+                std::vector<std::pair<int,int>> cells;
+                size_t added = moves.generate(cell_of(src), occupied, own, cells);
+                CHECK(added == static_cast<size_t>(bitboard::popcount(expected)));
+                for (const auto& cell : cells) {
+                    CHECK(bitboard::test(expected, cell.first * 8 + cell.second));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Moves::is_valid matches the cell-set overload") {
+    Moves queen = load_moves("QW");
+    std::mt19937_64 rng(7);
+
+    for (int round = 0; round < 20; ++round) {
+        Bitboard occupied = random_board(rng);
+        std::unordered_set<std::pair<int,int>, PairHash> cells;
+        for (int i = 0; i < 64; ++i) {
+            if (bitboard::test(occupied, i)) cells.insert(cell_of(i));
+        }
+        for (int src = 0; src < 64; ++src) {
+            for (int dst = 0; dst < 64; ++dst) {
+                CHECK(queen.is_valid(cell_of(src), cell_of(dst), occupied) ==
+                      queen.is_valid(cell_of(src), cell_of(dst), cells));
+            }
+        }
+    }
+}
+
+TEST_CASE("Sliders are blocked, leapers are not") {
+    Moves rook = load_moves("RW");
+    Moves knight = load_moves("NW");
+    Moves pawn = load_moves("PW");
+
+    Bitboard blocker = bitboard::bit(5 * 8 + 4);    // (5,4)
+    CHECK(rook.is_valid({7, 4}, {6, 4}, blocker));
+    CHECK(rook.is_valid({7, 4}, {5, 4}, blocker));  // capture the blocker
+    CHECK_FALSE(rook.is_valid({7, 4}, {4, 4}, blocker));
+
+    // Pawn double step needs the cell in front empty, and never captures ahead
+    CHECK(pawn.is_valid({6, 4}, {4, 4}, 0));
+    CHECK_FALSE(pawn.is_valid({6, 4}, {4, 4}, blocker));
+    CHECK_FALSE(pawn.is_valid({6, 4}, {5, 4}, blocker));
+
+    // Knight jumps over a wall of pieces
+    Bitboard wall = bitboard::bit(6 * 8 + 0) | bitboard::bit(6 * 8 + 1) | bitboard::bit(6 * 8 + 2);
+    CHECK(knight.is_valid({7, 1}, {5, 2}, wall));
+    CHECK(knight.generate({7, 1}, wall) == (bitboard::bit(5 * 8 + 0) | bitboard::bit(5 * 8 + 2) |
+                                            bitboard::bit(6 * 8 + 3)));
+}
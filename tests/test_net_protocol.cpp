@@ -0,0 +1,174 @@
+#include "doctest.h"
+
+#include "Game.hpp"
+#include "GameServer.hpp"
+#include "NetProtocol.hpp"
+#include "img/MockImg.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+net::Reader body_of(const net::FrameBuffer::Frame& frame) {
+    return net::Reader(frame.body, frame.size);
+}
+
+// One frame through a FrameBuffer
+Command decode_command(const std::string& bytes, uint32_t& seq) {
+    net::FrameBuffer buffer;
+    buffer.append(bytes.data(), bytes.size());
+    net::FrameBuffer::Frame frame;
+    REQUIRE(buffer.next(frame));
+    REQUIRE(frame.type == net::Msg::Command);
+    auto in = body_of(frame);
+    return net::read_command(in, seq);
+}
+
+PiecePtr find_piece(const Game& game, const std::string& id) {
+    for (const auto& piece : game.pieces) {
+        if (piece->id == id) return piece;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("FrameBuffer waits for a whole frame") {
+    std::string bytes;
+    net::write_reject(bytes, 7, "not your piece");
+    net::write_game_over(bytes, 'W');
+
+    // Byte by byte: each frame appears exactly when its last byte arrives
+    net::FrameBuffer buffer;
+    net::FrameBuffer::Frame frame;
+    std::vector<net::Msg> seen;
+    for (char c : bytes) {
+        buffer.append(&c, 1);
+        while (buffer.next(frame)) seen.push_back(frame.type);
+    }
+    CHECK(seen == std::vector<net::Msg>{net::Msg::Reject, net::Msg::GameOver});
+    CHECK(buffer.buffered() == 0);
+
+    // A frame cut short is not returned until the rest comes in
+    net::FrameBuffer partial;
+    partial.append(bytes.data(), 5);
+    CHECK_FALSE(partial.next(frame));
+    partial.append(bytes.data() + 5, bytes.size() - 5);
+    REQUIRE(partial.next(frame));
+    CHECK(frame.type == net::Msg::Reject);
+    auto in = body_of(frame);
+    CHECK(in.varint() == 7);
+    CHECK(in.text() == "not your piece");
+    CHECK(in.done());
+}
+
+TEST_CASE("FrameBuffer rejects a frame without a type") {
+    net::FrameBuffer buffer;
+    const char empty[] = {0, 0, 1};
+    buffer.append(empty, sizeof empty);
+    net::FrameBuffer::Frame frame;
+    CHECK_THROWS_AS(buffer.next(frame), std::runtime_error);
+}
+
+TEST_CASE("Writer refuses frames past kMaxFrame and leaves the buffer as it was") {
+    std::string out;
+    net::write_game_over(out, 'B');
+    const std::string before = out;
+    CHECK_THROWS_AS(net::write_reject(out, 1, std::string(net::kMaxFrame, 'x')), std::runtime_error);
+    CHECK(out == before);
+}
+
+// ---------------------------------------------------------------------------
+TEST_CASE("read_command round-trips a command") {
+    Command sent(0, "PW_(6,4)", "move", {{6, 4}, {4, 4}});
+    std::string bytes;
+    net::write_command(bytes, 42, sent);
+
+    uint32_t seq = 0;
+    Command got = decode_command(bytes, seq);
+    CHECK(seq == 42);
+    CHECK(got.piece_id == sent.piece_id);
+    CHECK(got.type == sent.type);
+    CHECK(got.params == sent.params);
+}
+
+TEST_CASE("read_command throws on truncated and oversized bodies") {
+    std::string bytes;
+    net::write_command(bytes, 1, Command(0, "PW_(6,4)", "move", {{6, 4}, {4, 4}}));
+    net::FrameBuffer buffer;
+    buffer.append(bytes.data(), bytes.size());
+    net::FrameBuffer::Frame frame;
+    REQUIRE(buffer.next(frame));
+    for (size_t cut = 0; cut < frame.size; ++cut) {
+        net::Reader in(frame.body, cut);
+        uint32_t seq = 0;
+        CHECK_THROWS_AS(net::read_command(in, seq), std::runtime_error);
+    }
+
+    uint32_t seq = 0;
+    std::string long_id;
+    net::write_command(long_id, 2, Command(0, std::string(65, 'P'), "move", {{6, 4}, {4, 4}}));
+    CHECK_THROWS_AS(decode_command(long_id, seq), std::runtime_error);
+
+    std::string many_params;
+    net::write_command(many_params, 3, Command(0, "QW_(7,3)", "move", {{0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}}));
+    CHECK_THROWS_AS(decode_command(many_params, seq), std::runtime_error);
+}
+
+TEST_CASE("Reader::count refuses counts the frame cannot hold") {
+    // A tick claiming a billion acks in a few bytes
+    std::string body;
+    net::Writer w(body);
+    w.varint(1);
+    w.varint(16);
+    w.fixed64(0);
+    w.varint(1000000000);
+    w.varint(5);
+    net::Reader in(reinterpret_cast<const uint8_t*>(body.data()), body.size());
+    net::TickFrame tick;
+    CHECK_THROWS_AS(net::read_tick(in, tick), std::runtime_error);
+}
+
+// ---------------------------------------------------------------------------
+TEST_CASE("Jumps are only accepted in place") {
+    Game game = create_game("pieces/", std::make_shared<MockImgFactory>(), false);
+    auto queen = find_piece(game, "QW_(7,4)");
+    REQUIRE(queen);
+
+    Command teleport(0, queen->id, "jump", {{0, 3}}, 1);
+    Command in_place(0, queen->id, "jump", {{7, 4}}, 1);
+    CHECK(GameServer::check_command(teleport, 'W') == nullptr);     // shape is fine
+    CHECK(GameServer::check_in_game(teleport, game) != nullptr);
+    CHECK(GameServer::check_in_game(in_place, game) == nullptr);
+    CHECK(GameServer::check_in_game(Command(0, "QW_(3,3)", "jump", {{3, 3}}, 1), game) != nullptr);
+
+    // The game refuses the teleport on its own as well
+    game.enqueue_command(Command(16, queen->id, "jump", {{0, 3}}, 1));
+    for (int t = 16; t <= 3000; t += 16) game.step_to(t);
+    CHECK(queen->current_cell() == std::make_pair(7, 4));
+}
+
+TEST_CASE("Only the promoting pawn's owner may choose its piece") {
+    auto img_factory = std::make_shared<MockImgFactory>();
+    Board board(80, 80, 8, 8, img_factory->load("pieces/board.png", {640, 640}));
+    auto factory = std::make_shared<PieceFactory>(board, "pieces/", GraphicsFactory(img_factory));
+    factory->preload({"QW", "QB", "RW", "RB", "BW", "BB", "NW", "NB"});
+
+    std::vector<PiecePtr> pieces = {
+        factory->create_piece("PW", {1, 0}),
+        factory->create_piece("KW", {7, 4}),
+        factory->create_piece("KB", {0, 4}),
+    };
+    Game game(pieces, board, factory, false);
+
+    game.enqueue_command(Command(16, "PW_(1,0)", "move", {{1, 0}, {0, 0}}, 1));
+    for (int t = 16; t <= 10000 && game.promoting_color() == 0; t += 16) game.step_to(t);
+    REQUIRE(game.promoting_color() == 'W');
+
+    CHECK(GameServer::check_in_game(Command(0, "", "promote_knight", {}, 2), game) != nullptr);
+    CHECK(GameServer::check_in_game(Command(0, "", "promote_queen", {}, 1), game) == nullptr);
+}
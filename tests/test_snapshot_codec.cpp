@@ -0,0 +1,107 @@
+#include "doctest.h"
+
+#include "SnapshotCodec.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+net::VisiblePiece piece(uint32_t handle, uint8_t cell, uint8_t state = net::kIdle, int start_ms = 0,
+                        int duration_ms = 0, uint8_t from = net::kNoCell) {
+    net::VisiblePiece p;
+    p.handle = handle;
+    p.state = state;
+    p.to = cell;
+    p.from = from == net::kNoCell ? cell : from;
+    p.start_ms = start_ms;
+    p.duration_ms = duration_ms;
+    return p;
+}
+
+void read(net::SnapshotDecoder& decoder, const std::string& section, int time_ms) {
+    net::Reader in(reinterpret_cast<const uint8_t*>(section.data()), section.size());
+    decoder.read(in, time_ms);
+    CHECK(in.done());
+}
+
+bool same_board(const std::vector<net::VisiblePiece>& a, const std::vector<net::VisiblePiece>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].handle != b[i].handle || !a[i].same_state(b[i])) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+TEST_CASE("SnapshotDecoder refuses a delta before any keyframe") {
+    net::SnapshotEncoder encoder;
+    encoder.set({piece(0, 8), piece(1, 9)}, 16);
+
+    net::SnapshotDecoder decoder;
+    net::Reader in(reinterpret_cast<const uint8_t*>(encoder.delta().data()), encoder.delta().size());
+    CHECK_THROWS_AS(decoder.read(in, 16), std::runtime_error);
+    CHECK_FALSE(decoder.has_keyframe());
+}
+
+TEST_CASE("Keyframe then deltas rebuild the board, with moves and removals") {
+    net::SnapshotEncoder encoder;
+    net::SnapshotDecoder decoder;
+
+    std::vector<net::VisiblePiece> board = {piece(0, 0), piece(1, 1), piece(2, 8), piece(5, 60)};
+    encoder.set(board, 16);
+    read(decoder, encoder.keyframe(), 16);
+    REQUIRE(decoder.has_keyframe());
+    CHECK(same_board(decoder.pieces(), board));
+
+    // Piece 2 starts moving, piece 1 is captured
+    board = {piece(0, 0), piece(2, 24, net::kMove, 32, 1000, 8), piece(5, 60)};
+    encoder.set(board, 32);
+    CHECK(encoder.changed() == 1);
+    read(decoder, encoder.delta(), 32);
+    CHECK(same_board(decoder.pieces(), board));
+
+    // Nothing changed: an empty delta
+    encoder.set(board, 48);
+    CHECK(encoder.changed() == 0);
+    read(decoder, encoder.delta(), 48);
+    CHECK(same_board(decoder.pieces(), board));
+
+    // A new handle (promotion) and the first and last pieces removed
+    board = {piece(2, 24, net::kLongRest, 1032, 2000), piece(6, 0, net::kIdle, 1040)};
+    encoder.set(board, 1040);
+    read(decoder, encoder.delta(), 1040);
+    CHECK(same_board(decoder.pieces(), board));
+
+    // A late viewer starting from this tick's keyframe sees the same board
+    net::SnapshotDecoder late;
+    read(late, encoder.keyframe(), 1040);
+    CHECK(same_board(late.pieces(), board));
+}
+
+TEST_CASE("Random boards round-trip through deltas") {
+    std::mt19937 rng(25);
+    net::SnapshotEncoder encoder;
+    net::SnapshotDecoder decoder;
+
+    int time_ms = 0;
+    for (int tick = 0; tick < 300; ++tick) {
+        time_ms += 16;
+        std::vector<net::VisiblePiece> board;
+        for (uint32_t handle = 0; handle < 40; ++handle) {
+            if (rng() % 4 == 0) continue;   // absent this tick
+            uint8_t cell = static_cast<uint8_t>(rng() % 64);
+            bool moving = rng() % 3 == 0;
+            board.push_back(piece(handle, cell, moving ? net::kMove : net::kIdle,
+                                  time_ms - static_cast<int>(rng() % 500), moving ? 800 : 0,
+                                  moving ? static_cast<uint8_t>(rng() % 64) : net::kNoCell));
+        }
+        encoder.set(board, time_ms);
+        read(decoder, tick % 50 == 0 ? encoder.keyframe() : encoder.delta(), time_ms);
+        REQUIRE(same_board(decoder.pieces(), board));
+    }
+}